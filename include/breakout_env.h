@@ -0,0 +1,108 @@
+#ifndef BREAKOUT_ENV_H
+#define BREAKOUT_ENV_H
+
+#include <stdint.h>
+
+/*
+ * Vectorized training environments (C ABI).
+ *
+ * One handle owns N independent games on the fixed-point rules
+ * (FixedSimulation), which are bit-identical on every machine. These are
+ * not the physics of the default float game: state is 16.16 fixed point,
+ * deflections come from rotation tables and speed-ups count whole frames,
+ * so trajectories differ from the float game's and a policy trained here
+ * plays a slightly different game there. Builds with
+ * BREAKOUT_FIXED_POINT play these exact rules. breakout_env_step
+ * advances all of them with one action each and writes the results straight
+ * into the caller's arrays; nothing is allocated or copied per step.
+ * Environments are split into contiguous ranges across a persistent thread
+ * pool, the calling thread taking the first range.
+ *
+ * Buffers, all contiguous and row-major over environments:
+ *   actions       int8_t  [N]                  -1 left, 0 stay, 1 right
+ *   observations  float   [N][BREAKOUT_ENV_STATE_SIZE]
+ *   bricks        uint64_t[N][breakout_env_brick_words()]  alive bitmask
+ *                          over grid cells, row-major, 64 per word
+ *   rewards       float   [N]                  bricks destroyed, minus
+ *                                              life_penalty per lost life
+ *   dones         uint8_t [N]                  BREAKOUT_ENV_* flags
+ * actions must not be NULL. observations, bricks, rewards and dones may be
+ * NULL to skip writing them.
+ *
+ * Pixel observations are rendered on the CPU (SoftwareRasterizer) after
+ * breakout_env_set_pixels, on the same thread split:
+ *   pixels        uint8_t [N][height][width][channels]  1 gray or 3 RGB
+ *
+ * A finished environment resets inside the same step: its done flag is set
+ * and its observation is already the first one of the next episode.
+ *
+ * From Python with ctypes and numpy:
+ *   lib = ctypes.CDLL("./libbreakout_env.so")
+ *   env = lib.breakout_env_create(4096, ctypes.byref(config))
+ *   lib.breakout_env_step(env, actions.ctypes.data, obs.ctypes.data, ...)
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Observation floats, in playfield units normalised to [0, 1] for positions
+ * and to playfield sizes per second for velocities */
+enum {
+    BREAKOUT_ENV_PADDLE_X = 0,   /* paddle centre */
+    BREAKOUT_ENV_BALL_X = 1,
+    BREAKOUT_ENV_BALL_Y = 2,
+    BREAKOUT_ENV_BALL_VX = 3,
+    BREAKOUT_ENV_BALL_VY = 4,
+    BREAKOUT_ENV_BALL_SPIN = 5,  /* -1 to 1 */
+    BREAKOUT_ENV_STATE_SIZE = 6
+};
+
+/* Bits in dones */
+enum {
+    BREAKOUT_ENV_TERMINATED = 1, /* out of lives or every brick cleared */
+    BREAKOUT_ENV_TRUNCATED = 2,  /* hit max_frames */
+    BREAKOUT_ENV_WON = 4
+};
+
+typedef struct BreakoutEnvConfig {
+    int mode;              /* GameMode: 0 Classic, 1 Mega Grid, 2 Chaos */
+    int frames_per_step;   /* action repeat, at least 1 */
+    int steps_per_second;  /* simulation tick rate, 60 in the game */
+    uint32_t max_frames;   /* truncation limit per episode, 0 for none */
+    float life_penalty;
+    uint32_t seed;
+    int threads;           /* 0 for one per hardware thread */
+} BreakoutEnvConfig;
+
+typedef struct BreakoutEnv BreakoutEnv;
+
+/* Defaults: Classic, 4 frames per step at 60 Hz, 5 minute episodes */
+BreakoutEnvConfig breakout_env_default_config(void);
+
+/* NULL if count or config are invalid */
+BreakoutEnv* breakout_env_create(int count, const BreakoutEnvConfig* config);
+void breakout_env_destroy(BreakoutEnv* env);
+
+int breakout_env_count(const BreakoutEnv* env);
+int breakout_env_brick_words(const BreakoutEnv* env);
+int breakout_env_thread_count(const BreakoutEnv* env);
+
+/* Starts new episodes everywhere and writes their first observations */
+void breakout_env_reset(BreakoutEnv* env, float* observations, uint64_t* bricks);
+
+void breakout_env_step(BreakoutEnv* env, const int8_t* actions, float* observations, uint64_t* bricks,
+                       float* rewards, uint8_t* dones);
+
+/* Chooses the pixel frame size; 0 on success, -1 if the size is invalid */
+int breakout_env_set_pixels(BreakoutEnv* env, int width, int height, int channels);
+
+/* Renders every environment's current state; does nothing before
+ * breakout_env_set_pixels */
+void breakout_env_render(BreakoutEnv* env, uint8_t* pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BREAKOUT_ENV_H */
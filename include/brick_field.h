@@ -0,0 +1,142 @@
+#ifndef BRICK_FIELD_H
+#define BRICK_FIELD_H
+
+#include <raylib.h>
+#include "ecs.h"
+#include "game_config.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// One cell of a compile-time brick layout. Positions are fractions of the
+// virtual screen so the table is independent of the window size.
+struct BrickCell {
+    float x;        // left edge, fraction of screen width
+    float yWidth;   // spacing contribution to the top edge, fraction of screen width
+    float yHeight;  // row contribution to the top edge, fraction of screen height
+    Color color;
+};
+
+// Brick layout table generated at compile time from a game config
+template <typename Config>
+struct BrickLayout {
+    static constexpr int ROWS = Config::ROWS;
+    static constexpr int COLS = Config::COLS;
+    static constexpr int COUNT = ROWS * COLS;
+    static constexpr float WIDTH = (1.0f - Config::BRICK_SPACING * (COLS + 1)) / COLS;
+
+    static constexpr std::array<BrickCell, COUNT> generate() {
+        std::array<BrickCell, COUNT> cells{};
+        for (int i = 0; i < ROWS; i++) {
+            for (int j = 0; j < COLS; j++) {
+                cells[i * COLS + j] = BrickCell{
+                    Config::BRICK_SPACING + j * (WIDTH + Config::BRICK_SPACING),
+                    Config::BRICK_SPACING * (i + 1),
+                    i * Config::BRICK_HEIGHT + Config::FIELD_TOP,
+                    Config::rowColor(i)
+                };
+            }
+        }
+        return cells;
+    }
+
+    static constexpr std::array<BrickCell, COUNT> CELLS = generate();
+};
+
+// A generated level on a mode's grid: hit points per cell, row-major like
+// GridCell::index, with 0 leaving the cell empty
+struct LevelDesign {
+    GameMode mode;
+    uint32_t seed;
+    int number;
+    std::vector<uint8_t> hitPoints;
+
+    int brickCount() const {
+        int count = 0;
+        for (uint8_t points : hitPoints) {
+            count += points > 0 ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+// Bricks of one game mode. The bricks themselves are entities in the World;
+// this spawns them from the compile-time layout and relays them out when the
+// screen size changes.
+template <typename Config>
+class BrickField {
+public:
+    using ConfigType = Config;
+    using Layout = BrickLayout<Config>;
+    static constexpr int COUNT = Layout::COUNT;
+    static constexpr int SCORE_VALUE = 100;
+
+    static void spawn(World& world, float screenWidth, float screenHeight) {
+        world.archetype<BrickArchetype>().reserve(COUNT);
+        for (int i = 0; i < COUNT; i++) {
+            create(world, i, 1);
+        }
+        layout(world, screenWidth, screenHeight);
+    }
+
+    // Only the cells the level fills; tougher bricks are darker and worth
+    // their hit points in score
+    static void spawn(World& world, float screenWidth, float screenHeight, const LevelDesign& level) {
+        world.archetype<BrickArchetype>().reserve(level.brickCount());
+        for (int i = 0; i < COUNT && i < static_cast<int>(level.hitPoints.size()); i++) {
+            if (level.hitPoints[i] > 0) {
+                create(world, i, level.hitPoints[i]);
+            }
+        }
+        layout(world, screenWidth, screenHeight);
+    }
+
+    // Position every remaining brick for the given screen size. The whole
+    // grid is laid out in a loop of exactly COUNT iterations over the
+    // constexpr table, which the compiler can unroll and vectorize; the live
+    // bricks then pick their cell out of it by grid index.
+    static void layout(World& world, float screenWidth, float screenHeight) {
+        std::array<float, COUNT> cellX;
+        std::array<float, COUNT> cellY;
+        for (int i = 0; i < COUNT; i++) {
+            cellX[i] = screenWidth * Layout::CELLS[i].x;
+            cellY[i] = screenWidth * Layout::CELLS[i].yWidth + screenHeight * Layout::CELLS[i].yHeight;
+        }
+
+        const float width = screenWidth * Layout::WIDTH;
+        const float height = screenHeight * Config::BRICK_HEIGHT;
+        BrickArchetype& bricks = world.archetype<BrickArchetype>();
+        std::vector<Position>& positions = bricks.column<Position>();
+        std::vector<Collider>& colliders = bricks.column<Collider>();
+        const std::vector<GridCell>& cells = bricks.column<GridCell>();
+        for (size_t row = 0; row < bricks.size(); row++) {
+            const int index = cells[row].index;
+            positions[row].x = cellX[index];
+            positions[row].y = cellY[index];
+            colliders[row].width = width;
+            colliders[row].height = height;
+        }
+    }
+
+private:
+    static void create(World& world, int index, int hitPoints) {
+        const Color color = Layout::CELLS[index].color;
+        const int shade = 100 - 25 * (hitPoints - 1);
+        world.create<BrickArchetype>(
+            Position{0.0f, 0.0f},
+            Collider{ColliderShape::BOX, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1},
+            Health{hitPoints, SCORE_VALUE * hitPoints},
+            Render{Color{static_cast<unsigned char>(color.r * shade / 100),
+                         static_cast<unsigned char>(color.g * shade / 100),
+                         static_cast<unsigned char>(color.b * shade / 100), color.a}, RenderLayer::BRICKS},
+            GridCell{index}
+        );
+    }
+};
+
+// Config type of a BrickField reference, for use inside generic visitors
+template <typename Field>
+using ConfigOf = typename std::decay_t<Field>::ConfigType;
+
+#endif // BRICK_FIELD_H
@@ -0,0 +1,67 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <raylib.h>
+#include <vector>
+
+// Incremental sweep-and-prune broadphase on the x axis.
+//
+// Bodies are axis-aligned boxes tagged with a category bit and a mask of the
+// categories they want to collide with. Endpoints stay sorted between calls,
+// so with frame-to-frame coherence the insertion sort in findPairs is close
+// to linear. Candidate pairs are then handed to the caller's narrow phase.
+class SweepAndPrune {
+public:
+    struct Pair {
+        int a;  // lower handle
+        int b;
+    };
+
+    SweepAndPrune();
+
+    int add(const Rectangle& bounds, unsigned int category, unsigned int mask, int userData);
+    void remove(int handle);
+    void update(int handle, const Rectangle& bounds);
+    void setEnabled(int handle, bool enabled);
+    void clear();
+    // Sizes the storage for count bodies; clear() keeps it
+    void reserve(int count);
+
+    // Re-sorts the endpoints and returns every overlapping pair whose masks match
+    const std::vector<Pair>& findPairs();
+
+    unsigned int getCategory(int handle) const { return bodies[handle].category; }
+    int getUserData(int handle) const { return bodies[handle].userData; }
+    int getBodyCount() const { return bodyCount; }
+    int getLastSortSwaps() const { return lastSortSwaps; }
+
+private:
+    struct Body {
+        Rectangle bounds;
+        unsigned int category;
+        unsigned int mask;
+        int userData;
+        int activeSlot;  // index in the active list during a sweep, -1 otherwise
+        bool enabled;
+        bool inUse;
+    };
+
+    struct Endpoint {
+        float value;
+        int body;
+        bool isMin;
+    };
+
+    static bool comesBefore(const Endpoint& lhs, const Endpoint& rhs);
+    void sortEndpoints();
+
+    std::vector<Body> bodies;
+    std::vector<int> freeHandles;
+    std::vector<Endpoint> endpoints;
+    std::vector<int> active;
+    std::vector<Pair> pairs;
+    int bodyCount;
+    int lastSortSwaps;
+};
+
+#endif // BROADPHASE_H
@@ -0,0 +1,331 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Lightweight entity-component storage.
+//
+// Every entity kind is an archetype: a fixed set of components stored as one
+// contiguous array per component. The set of archetypes is known at compile
+// time, so World::each<Components...> resolves which archetypes match while
+// compiling and the systems end up as plain loops over packed arrays.
+
+// Components ----------------------------------------------------------------
+
+// Top-left corner for boxes, centre for circles
+struct Position {
+    float x;
+    float y;
+};
+
+// Unit direction plus a maintained speed scalar; spin bends balls sideways
+struct Velocity {
+    float dirX;
+    float dirY;
+    float speed;
+    float spin;
+};
+
+enum class ColliderShape : uint8_t {
+    BOX,
+    CIRCLE
+};
+
+struct Collider {
+    ColliderShape shape;
+    float width;
+    float height;
+    float radius;
+    float baseWidth;   // size at the 800x600 base resolution, for rescaling
+    float baseHeight;
+    float baseRadius;
+    int broadphaseHandle;
+};
+
+struct Health {
+    int hitPoints;
+    int scoreValue;
+};
+
+enum class RenderLayer : uint8_t {
+    BRICKS,   // cached in the brick layer texture
+    DYNAMIC   // drawn every frame
+};
+
+struct Render {
+    Color color;
+    RenderLayer layer;
+};
+
+// Position in the mode's compile-time brick layout
+struct GridCell {
+    int index;
+};
+
+// Tags
+struct BallTag {};
+struct PaddleTag {};
+struct PowerUpTag {};
+
+// Storage -------------------------------------------------------------------
+
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+constexpr Entity NULL_ENTITY = { 0xFFFFFFFFu, 0 };
+
+template <typename... Components>
+class Archetype {
+public:
+    template <typename C>
+    static constexpr bool HAS = (std::is_same_v<C, Components> || ...);
+
+    size_t size() const { return entities.size(); }
+    const std::vector<Entity>& getEntities() const { return entities; }
+
+    template <typename C> std::vector<C>& column() { return std::get<std::vector<C>>(columns); }
+    template <typename C> const std::vector<C>& column() const { return std::get<std::vector<C>>(columns); }
+
+    uint32_t push(Entity entity, const Components&... values) {
+        entities.push_back(entity);
+        (column<Components>().push_back(values), ...);
+        return static_cast<uint32_t>(entities.size() - 1);
+    }
+
+    // Moves the last row into the hole; returns the entity that moved
+    Entity swapRemove(uint32_t row) {
+        uint32_t last = static_cast<uint32_t>(entities.size() - 1);
+        Entity moved = entities[last];
+        if (row != last) {
+            entities[row] = moved;
+            ((column<Components>()[row] = column<Components>()[last]), ...);
+        }
+        entities.pop_back();
+        (column<Components>().pop_back(), ...);
+        return moved;
+    }
+
+    void reserve(size_t count) {
+        entities.reserve(count);
+        (column<Components>().reserve(count), ...);
+    }
+
+    void clear() {
+        entities.clear();
+        (column<Components>().clear(), ...);
+    }
+
+private:
+    std::vector<Entity> entities;
+    std::tuple<std::vector<Components>...> columns;
+};
+
+using BrickArchetype = Archetype<Position, Collider, Health, Render, GridCell>;
+using PaddleArchetype = Archetype<Position, Velocity, Collider, Render, PaddleTag>;
+using BallArchetype = Archetype<Position, Velocity, Collider, Render, BallTag>;
+using PowerUpArchetype = Archetype<Position, Velocity, Collider, Render, PowerUpTag>;
+
+class World {
+public:
+    // Archetypes in draw order
+    using Archetypes = std::tuple<BrickArchetype, PaddleArchetype, BallArchetype, PowerUpArchetype>;
+
+    template <typename Arch, typename... Components>
+    Entity create(const Components&... values) {
+        constexpr uint8_t archetypeId = indexOf<Arch>();
+        Entity entity = allocate();
+        records[entity.index].archetype = archetypeId;
+        records[entity.index].row = std::get<Arch>(archetypes).push(entity, values...);
+        return entity;
+    }
+
+    void destroy(Entity entity) {
+        if (!isAlive(entity)) {
+            return;
+        }
+        Record& record = records[entity.index];
+        forEachArchetype(archetypes, [&](auto& arch, size_t id) {
+            if (id == record.archetype) {
+                Entity moved = arch.swapRemove(record.row);
+                if (moved != entity) {
+                    records[moved.index].row = record.row;
+                }
+            }
+        });
+        record.generation++;
+        record.alive = false;
+        freeIndices.push_back(entity.index);
+        liveCount--;
+    }
+
+    bool isAlive(Entity entity) const {
+        return entity.index < records.size() && records[entity.index].alive &&
+               records[entity.index].generation == entity.generation;
+    }
+
+    // Current handle for a slot index (e.g. one stored as broadphase user data)
+    Entity entityAt(uint32_t index) const {
+        return Entity{index, records[index].generation};
+    }
+
+    // Component lookup; null if the entity is gone or lacks the component
+    template <typename C>
+    C* tryGet(Entity entity) {
+        C* result = nullptr;
+        if (!isAlive(entity)) {
+            return result;
+        }
+        const Record& record = records[entity.index];
+        forEachArchetype(archetypes, [&](auto& arch, size_t id) {
+            if constexpr (std::decay_t<decltype(arch)>::template HAS<C>) {
+                if (id == record.archetype) {
+                    result = &arch.template column<C>()[record.row];
+                }
+            }
+        });
+        return result;
+    }
+
+    template <typename C>
+    const C* tryGet(Entity entity) const {
+        const C* result = nullptr;
+        if (!isAlive(entity)) {
+            return result;
+        }
+        const Record& record = records[entity.index];
+        forEachArchetype(archetypes, [&](const auto& arch, size_t id) {
+            if constexpr (std::decay_t<decltype(arch)>::template HAS<C>) {
+                if (id == record.archetype) {
+                    result = &arch.template column<C>()[record.row];
+                }
+            }
+        });
+        return result;
+    }
+
+    template <typename C>
+    C& get(Entity entity) { return *tryGet<C>(entity); }
+    template <typename C>
+    const C& get(Entity entity) const { return *tryGet<C>(entity); }
+
+    // Calls fn(entity, components...) for every entity having all of Query
+    template <typename... Query, typename Fn>
+    void each(Fn&& fn) {
+        forEachArchetype(archetypes, [&](auto& arch, size_t) {
+            using Arch = std::decay_t<decltype(arch)>;
+            if constexpr ((Arch::template HAS<Query> && ...)) {
+                const size_t count = arch.size();
+                const Entity* entities = arch.getEntities().data();
+                std::tuple<Query*...> data(arch.template column<Query>().data()...);
+                for (size_t i = 0; i < count; i++) {
+                    fn(entities[i], std::get<Query*>(data)[i]...);
+                }
+            }
+        });
+    }
+
+    template <typename... Query, typename Fn>
+    void each(Fn&& fn) const {
+        forEachArchetype(archetypes, [&](const auto& arch, size_t) {
+            using Arch = std::decay_t<decltype(arch)>;
+            if constexpr ((Arch::template HAS<Query> && ...)) {
+                const size_t count = arch.size();
+                const Entity* entities = arch.getEntities().data();
+                std::tuple<const Query*...> data(arch.template column<Query>().data()...);
+                for (size_t i = 0; i < count; i++) {
+                    fn(entities[i], std::get<const Query*>(data)[i]...);
+                }
+            }
+        });
+    }
+
+    // Destroys every entity of one archetype
+    template <typename Arch>
+    void destroyAll() {
+        Arch& arch = std::get<Arch>(archetypes);
+        for (const Entity& entity : arch.getEntities()) {
+            records[entity.index].alive = false;
+            records[entity.index].generation++;
+            freeIndices.push_back(entity.index);
+        }
+        liveCount -= arch.size();
+        arch.clear();
+    }
+
+    template <typename Arch> Arch& archetype() { return std::get<Arch>(archetypes); }
+    template <typename Arch> const Arch& archetype() const { return std::get<Arch>(archetypes); }
+
+    size_t getEntityCount() const { return liveCount; }
+
+    void clear() {
+        std::apply([](auto&... arch) { (arch.clear(), ...); }, archetypes);
+        for (uint32_t i = 0; i < records.size(); i++) {
+            if (records[i].alive) {
+                records[i].alive = false;
+                records[i].generation++;
+                freeIndices.push_back(i);
+            }
+        }
+        liveCount = 0;
+    }
+
+private:
+    struct Record {
+        uint32_t generation;
+        uint32_t row;
+        uint8_t archetype;
+        bool alive;
+    };
+
+    template <typename Arch, size_t I = 0>
+    static constexpr uint8_t indexOf() {
+        static_assert(I < std::tuple_size_v<Archetypes>, "not a World archetype");
+        if constexpr (std::is_same_v<Arch, std::tuple_element_t<I, Archetypes>>) {
+            return I;
+        } else {
+            return indexOf<Arch, I + 1>();
+        }
+    }
+
+    template <typename Tuple, typename Fn>
+    static void forEachArchetype(Tuple& tuple, Fn&& fn) {
+        forEachArchetypeImpl(tuple, fn, std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{});
+    }
+
+    template <typename Tuple, typename Fn, size_t... I>
+    static void forEachArchetypeImpl(Tuple& tuple, Fn& fn, std::index_sequence<I...>) {
+        (fn(std::get<I>(tuple), I), ...);
+    }
+
+    Entity allocate() {
+        uint32_t index;
+        if (!freeIndices.empty()) {
+            index = freeIndices.back();
+            freeIndices.pop_back();
+        } else {
+            index = static_cast<uint32_t>(records.size());
+            records.push_back(Record{0, 0, 0, false});
+        }
+        records[index].alive = true;
+        liveCount++;
+        return Entity{index, records[index].generation};
+    }
+
+    Archetypes archetypes;
+    std::vector<Record> records;
+    std::vector<uint32_t> freeIndices;
+    size_t liveCount = 0;
+};
+
+#endif // ECS_H
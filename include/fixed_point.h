@@ -0,0 +1,91 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+
+// 16.16 signed fixed-point number.
+//
+// Integer arithmetic produces the same bits on every target (wasm, x86, ARM)
+// no matter how the compiler treats floats: FMA contraction, x87 excess
+// precision and -ffast-math all leave it alone. Products are widened to 64
+// bits; right shifts of negative values are arithmetic on every compiler
+// this builds with (checked below).
+static_assert((-3 >> 1) == -2, "fixed point needs arithmetic right shifts");
+
+struct Fixed {
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRACTION_BITS;
+
+    int32_t raw;
+
+    static constexpr Fixed fromRaw(int32_t raw) { return Fixed{raw}; }
+    static constexpr Fixed fromInt(int value) { return Fixed{value * ONE}; }
+    // Rounds to nearest. The double arithmetic is exact, so this is stable
+    // across targets too; use it for constants and input, not per-frame maths.
+    static constexpr Fixed fromFloat(float value) {
+        double scaled = static_cast<double>(value) * ONE;
+        return Fixed{static_cast<int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5)};
+    }
+
+    // For drawing and debugging only
+    float toFloat() const { return static_cast<float>(raw) / ONE; }
+
+    constexpr Fixed operator-() const { return Fixed{-raw}; }
+    constexpr Fixed operator+(Fixed other) const { return Fixed{raw + other.raw}; }
+    constexpr Fixed operator-(Fixed other) const { return Fixed{raw - other.raw}; }
+    constexpr Fixed operator*(Fixed other) const {
+        return Fixed{static_cast<int32_t>((static_cast<int64_t>(raw) * other.raw) >> FRACTION_BITS)};
+    }
+    constexpr Fixed operator/(Fixed other) const {
+        return Fixed{static_cast<int32_t>((static_cast<int64_t>(raw) << FRACTION_BITS) / other.raw)};
+    }
+    constexpr Fixed operator*(int value) const { return Fixed{raw * value}; }
+    constexpr Fixed operator/(int value) const { return Fixed{raw / value}; }
+    constexpr Fixed half() const { return Fixed{raw >> 1}; }
+
+    Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+    Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+
+    constexpr bool operator<(Fixed other) const { return raw < other.raw; }
+    constexpr bool operator>(Fixed other) const { return raw > other.raw; }
+    constexpr bool operator<=(Fixed other) const { return raw <= other.raw; }
+    constexpr bool operator>=(Fixed other) const { return raw >= other.raw; }
+    constexpr bool operator==(Fixed other) const { return raw == other.raw; }
+    constexpr bool operator!=(Fixed other) const { return raw != other.raw; }
+};
+
+struct FixedVector {
+    Fixed x;
+    Fixed y;
+};
+
+constexpr Fixed fixedAbs(Fixed value) { return value.raw < 0 ? -value : value; }
+constexpr Fixed fixedMin(Fixed a, Fixed b) { return a < b ? a : b; }
+constexpr Fixed fixedMax(Fixed a, Fixed b) { return a < b ? b : a; }
+constexpr Fixed fixedClamp(Fixed value, Fixed low, Fixed high) { return fixedMin(fixedMax(value, low), high); }
+
+// Squared length in 32.32, which can't overflow for on-screen distances
+constexpr int64_t fixedLengthSquared(Fixed x, Fixed y) {
+    return static_cast<int64_t>(x.raw) * x.raw + static_cast<int64_t>(y.raw) * y.raw;
+}
+
+// floor(sqrt(value)), bit by bit; sqrt of a 32.32 value is a 16.16 value
+constexpr uint32_t integerSqrt(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = 1ull << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,201 @@
+#ifndef FIXED_SIMULATION_H
+#define FIXED_SIMULATION_H
+
+#include "fixed_point.h"
+#include "game_config.h"
+#include "simulation.h"
+#include <cstdint>
+#include <vector>
+
+// Fixed-point variant of Simulation for replays and server-side score
+// validation, where every target has to agree on the exact trajectory.
+//
+// Same rules and frame order as Simulation, but all state is 16.16 fixed
+// point and the deflection/perturbation rotations come from tables generated
+// at compile time with integer arithmetic, so there is no float or libm
+// anywhere in a step. Bricks never move, so candidates come straight from
+// their grid cells instead of a broadphase.
+//
+// The tick rate is an integer and speeds are divided by it, so there is no
+// rounded dt. Input is the paddle axis (-1, 0 or 1) per frame, which is
+// what a replay records.
+//
+// Builds with BREAKOUT_FIXED_POINT play the game on it (see Game), one
+// step() per frame. fastForward() is the event-driven way through the same
+// session: it finds the next frame on which anything can happen (a wall,
+// brick or paddle contact, a speed-up) and moves straight there. Between
+// events the ball's steps are constant once its spin has decayed, so the
+// skipped frames are summed with the very integer operations step() would
+// have applied one by one, and a fast-forwarded session lands on the same
+// bits as the stepped game session with the same input.
+class FixedSimulation;
+
+// Drives the paddle for the controller overloads. axis() is called for every
+// frame, including the ones fastForward skips, so it may only depend on the
+// frame and the paddle. onEvent() sees the state after every event frame.
+class FixedPaddleController {
+public:
+    virtual ~FixedPaddleController() = default;
+    virtual void onEvent(const FixedSimulation& simulation) { (void)simulation; }
+    virtual int axis(uint32_t frame, Fixed paddleX) = 0;
+};
+
+class FixedSimulation {
+public:
+    static constexpr int INITIAL_LIVES = 3;
+
+    FixedSimulation(GameMode mode, int stepsPerSecond, uint32_t seed);
+    // Plays a generated level instead of the mode's full grid
+    FixedSimulation(const LevelDesign& level, int stepsPerSecond, uint32_t seed);
+    void reset(uint32_t seed);
+
+    // One frame; returns SimulationEvent bits
+    uint32_t step(int paddleAxis);
+    uint32_t step(FixedPaddleController& controller);
+    // Before the first step() after a serve: moves the paddle by one frame's
+    // input and carries the waiting ball along, without advancing the frame,
+    // so the serve can be aimed as in the float game. A replay records these
+    // axes along with step()'s. Does nothing once the ball has moved.
+    void aimServe(int paddleAxis);
+    // Advances up to maxFrames, stopping after the first frame with an event.
+    // Returns that frame's events, or 0 if the limit or the end came first.
+    uint32_t fastForward(FixedPaddleController& controller, uint32_t maxFrames);
+
+    bool isOver() const { return lives <= 0 || bricksLeft == 0; }
+    bool isWon() const { return bricksLeft == 0; }
+    uint32_t getFrame() const { return frame; }
+    int getScore() const { return score; }
+    int getLives() const { return lives; }
+    int getBricksLeft() const { return bricksLeft; }
+
+    FixedVector getBallPosition() const { return FixedVector{ballX, ballY}; }
+    FixedVector getBallDirection() const { return FixedVector{dirX, dirY}; }
+    Fixed getBallSpeed() const { return speed; }
+    Fixed getBallSpin() const { return spin; }
+    Fixed getBallRadius() const { return ballRadius; }
+    Fixed getPaddleX() const { return paddleX; }
+    Fixed getPaddleY() const { return paddleY; }
+    Fixed getPaddleWidth() const { return paddleWidth; }
+    Fixed getPaddleHeight() const { return paddleHeight; }
+    FixedVector getPlayfieldSize() const { return FixedVector{width, height}; }
+    GameMode getMode() const { return mode; }
+
+    // Alive bricks as a bitmask over grid cells, 64 per word
+    int getBrickCount() const { return brickCount; }
+    const std::vector<uint64_t>& getBrickAlive() const { return brickAlive; }
+    bool isBrickAlive(int index) const { return (brickAlive[index / 64] >> (index % 64)) & 1; }
+    int getBrickHitPoints(int index) const { return brickHits[index]; }
+    // Grid cell of the brick hit on the last frame with SIM_EVENT_BRICK
+    int getLastBrickHit() const { return lastBrickHit; }
+    FixedVector getBrickCorner(int index) const { return brickCorners[index]; }
+    FixedVector getBrickSize() const { return FixedVector{brickWidth, brickHeight}; }
+
+    // First frame the falling ball reaches the paddle's top edge in its
+    // current line, UINT32_MAX if it is rising; and where it crosses that
+    // line then, folded back between the side walls
+    uint32_t predictPaddleLineFrame() const;
+    Fixed predictPaddleLineX(uint32_t atFrame) const;
+
+    // FNV-1a over the raw state; equal hashes mean bit-identical runs
+    uint64_t stateHash() const;
+
+private:
+    // Ball centre in raw 16.16, widened so far-off predictions can't
+    // overflow, and the spin left by then
+    struct BallPoint {
+        int64_t x;
+        int64_t y;
+        Fixed spin;
+    };
+
+    // The ball's steps until something touches it
+    struct BallPath {
+        Fixed stepX;
+        Fixed stepY;
+        uint32_t spinFrames;  // until the spin has decayed to zero
+        int64_t spinX;        // x moved in those frames
+    };
+
+    BallPath ballPath() const;
+    BallPoint ballAfter(const BallPath& path, uint32_t frames) const;
+    uint32_t nextEventFrame(uint32_t limit) const;
+    void skipFrames(FixedPaddleController& controller, uint32_t frames);
+
+    template <typename Config> void setup();
+    void serve();
+    void addSpin(Fixed amount);
+    Fixed decaySpin(Fixed value) const;
+    bool bounceOffWalls();
+    bool ballOverlaps(Fixed x, Fixed y, Fixed width, Fixed height) const;
+    bool resolvePaddle(int paddleAxis);
+    bool resolveBricks();
+    uint32_t nextRandom();
+
+    GameMode mode;
+    LevelDesign level;  // no hit points: the full grid
+    int stepsPerSecond;
+    Fixed width;
+    Fixed height;
+
+    // Tuning; speeds per second, the rest per frame
+    Fixed paddleStep;
+    Fixed ballBaseSpeed;
+    Fixed speedIncrement;
+    Fixed maxSpeed;
+    Fixed spinDecay;
+    uint32_t speedUpFrames;
+
+    // Bricks on their grid, row-major like GridCell::index
+    int rows;
+    int cols;
+    int brickCount;
+    Fixed brickWidth;
+    Fixed brickHeight;
+    std::vector<FixedVector> brickCorners;  // top-left per cell
+    std::vector<uint64_t> brickAlive;
+    std::vector<uint8_t> brickHits;  // hit points left per cell
+    int lastBrickHit;
+    bool serving;  // served and not stepped since
+
+    Fixed paddleX;
+    Fixed paddleY;
+    Fixed paddleWidth;
+    Fixed paddleHeight;
+
+    Fixed ballX;
+    Fixed ballY;
+    Fixed ballRadius;
+    Fixed dirX;
+    Fixed dirY;
+    Fixed speed;
+    Fixed spin;
+
+    uint32_t frame;
+    uint32_t lastSpeedUpFrame;
+    uint32_t rngState;
+    int score;
+    int lives;
+    int bricksLeft;
+};
+
+// TrackingBot on the fixed-point rules: steers towards where the ball will
+// cross the paddle line, aiming off centre by a random amount. Decisions are
+// only made on events, so it is valid for fastForward.
+class FixedTrackingBot : public FixedPaddleController {
+public:
+    explicit FixedTrackingBot(uint32_t seed);
+
+    void onEvent(const FixedSimulation& simulation) override;
+    int axis(uint32_t frame, Fixed paddleX) override;
+
+private:
+    static constexpr Fixed DEAD_ZONE = Fixed::fromInt(10);
+
+    uint32_t next();
+
+    uint32_t rng;
+    Fixed target;
+    Fixed paddleWidth;
+};
+
+#endif // FIXED_SIMULATION_H
@@ -0,0 +1,120 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Deferrable work (telemetry flushes, save I/O, level validation) run in
+// whatever time the frame has left instead of unconditionally.
+//
+// Tasks run in one of two phases. BEFORE_DRAW tasks may change what is on
+// screen, so the game runs them (run) just before recording the frame.
+// AFTER_DRAW tasks are I/O that must not land before the frame that caused
+// it is shown; the game runs them (runAfterDraw) at the top of the next
+// loop iteration, right after the previous EndDrawing, since EndDrawing may
+// wait out the rest of its own frame. Either way a run hands pending tasks,
+// highest priority first, the time left until the frame's deadline minus
+// what the rest of the frame is expected to take: drawing, and for
+// runAfterDraw also the update and recording still ahead of it. A task
+// whose usual cost doesn't fit stays pending and is offered again next
+// frame. Sliced tasks take a budget and do part of their work in it, at
+// most their slice per frame; idle runs aren't capped.
+//
+// Runs return only the time spent before the deadline: what a forced or
+// overlong task takes past it made the frame late and is the frame's work.
+//
+// A task left waiting MAX_WAIT_FRAMES frames is forced through on the next
+// one regardless of budget, so nothing starves when frames run long.
+class FrameScheduler {
+public:
+    enum class Priority : uint8_t {
+        HIGH,
+        NORMAL,
+        LOW
+    };
+
+    enum class Phase : uint8_t {
+        BEFORE_DRAW,
+        AFTER_DRAW
+    };
+
+    // Gets the budget in seconds; returns true if work is left, which keeps
+    // the task pending
+    using TaskFunction = std::function<bool(double budget)>;
+
+    struct TaskStats {
+        double averageSeconds;
+        double maxSeconds;
+        uint32_t runs;
+        uint32_t deferrals;  // frames pending without running
+        uint32_t forcedRuns;
+    };
+
+    static constexpr int MAX_WAIT_FRAMES = 30;        // ~0.5 s at 60 FPS
+    static constexpr double SAFETY_MARGIN = 0.002;    // kept free before the deadline
+    static constexpr double MIN_SLICE = 0.0005;       // smallest budget worth giving a sliced task
+    static constexpr double COST_SMOOTHING = 0.1;     // weight of the newest sample in running averages
+
+    explicit FrameScheduler(double framePeriod);
+
+    // Names must be string literals (they double as profiler stat names).
+    // slice is 0 for tasks that run to completion, otherwise the most time a
+    // sliced task gets per run.
+    int addTask(const char* name, Priority priority, Phase phase, double slice, TaskFunction function);
+    void request(int task);
+    bool isPending(int task) const { return tasks[task].pending; }
+
+    void beginFrame();
+    // Time spent issuing draw calls, which the budget reserves
+    void addDrawCost(double seconds);
+    // Time spent on the frame's update and recording, which runAfterDraw
+    // also reserves
+    void addWorkCost(double seconds);
+
+    // Run what fits of one phase before the deadline; return the seconds
+    // spent
+    double run();
+    double runAfterDraw();
+    // Runs everything pending, of both phases, within a fixed budget, for
+    // idle ticks
+    double runIdle(double budget);
+
+    int getTaskCount() const { return static_cast<int>(tasks.size()); }
+    const char* getTaskName(int task) const { return tasks[task].name; }
+    const TaskStats& getTaskStats(int task) const { return tasks[task].stats; }
+    double getLastBudget() const { return lastBudget; }
+    double getDrawCost() const { return drawCost; }
+    double getWorkCost() const { return workCost; }
+    int getLastRunCount() const { return lastRunCount; }
+    int getLastDeferredCount() const { return lastDeferredCount; }
+
+private:
+    struct Task {
+        const char* name;
+        Priority priority;
+        Phase phase;
+        double slice;
+        TaskFunction function;
+        bool pending;
+        int framesWaiting;
+        TaskStats stats;
+    };
+
+    // phase null for both; idle ignores the slice caps
+    double runPending(double deadline, const Phase* phase, bool idle);
+    bool fits(const Task& task, double remaining) const;
+    void execute(Task& task, double budget);
+
+    std::vector<Task> tasks;
+    std::vector<int> order;  // scratch for run
+    double framePeriod;
+    double frameStart;
+    double drawCost;
+    double workCost;
+    double lastBudget;
+    int lastRunCount;
+    int lastDeferredCount;
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -2,7 +2,25 @@
 #define GAME_H
 
 #include <raylib.h>
-#include <memory>
+#include "brick_field.h"
+#include "broadphase.h"
+#include "ecs.h"
+#include "frame_scheduler.h"
+#include "game_config.h"
+#ifdef BREAKOUT_FIXED_POINT
+#include "fixed_simulation.h"
+#endif
+#include "level_generator.h"
+#include "profiler.h"
+#include "quality_governor.h"
+#include "render_commands.h"
+#include "save_store.h"
+#include "software_raster.h"
+#include "spectator_stream.h"
+#include "spectator_view.h"
+#include "systems.h"
+#include "telemetry.h"
+#include <variant>
 #include <vector>
 #include <algorithm>
 
@@ -12,9 +30,7 @@ public:
         // Base dimensions and speeds (unchanged by scaling)
         static constexpr float BASE_WINDOW_WIDTH = 800.0f;
         static constexpr float BASE_WINDOW_HEIGHT = 600.0f;
-        static constexpr float PADDLE_BASE_SPEED = 500.0f;
-        static constexpr float BALL_BASE_SPEED = 300.0f;
-        static constexpr float BALL_SPEED_INCREMENT = 10.0f;
+        // Speeds are per game mode, see game_config.h
         
         // Dynamic virtual dimensions that change with screen size
         static float VIRTUAL_WIDTH;
@@ -33,92 +49,25 @@ public:
             VIRTUAL_WIDTH = static_cast<float>(GetScreenWidth());
             VIRTUAL_HEIGHT = static_cast<float>(GetScreenHeight());
         }
-    };
-
-    class Paddle {
-    public:
-        Paddle(float x, float y, float width, float height, float speed);
-        void update(float deltaTime);
-        void draw();
-        Rectangle getRect() const;
-        void setX(float newX);
-        void clampToScreen();
-        float getBaseSpeed() const { return baseSpeed; }
-        void updateDimensions();  // New method to update dimensions when screen changes
-        void updateTouchInput(float deltaTime);  // New method to handle touch input
-        void setTouchEnabled(bool enabled) { touchEnabled = enabled; }
-        bool isTouchEnabled() const { return touchEnabled; }
-
-    private:
-        float x;
-        float y;
-        float width;
-        float height;
-        float baseSpeed;
-        float baseWidth;  // Store original width for scaling
-        float baseHeight; // Store original height for scaling
-        bool touchActive;  // Tracks if touch is currently active
-        float lastTouchX;  // Last touch X position
-        bool touchEnabled; // Whether touch controls are enabled
-    };
 
-    class Ball {
-    public:
-        Ball(float x, float y, float radius, float speedX, float speedY);
-        void update(float deltaTime);
-        void draw();
-        Vector2 getPosition() const;
-        float getRadius() const;
-        void setPosition(float x, float y);
-        void reverseX();
-        void reverseY();
-        void increaseSpeed(float increment);
-        void setSpeed(float newSpeedX, float newSpeedY);
-        void clampSpeed(float maxSpeed);
-        void clampToScreen();
-        float getSpeedX() const { return baseSpeedX; }
-        float getSpeedY() const { return baseSpeedY; }
-        void updateDimensions();
-        void setVelocity(float angleInRadians, float speed);
-        void addSpin(float spinValue);
-        void applySpinDecay(float deltaTime);
-
-    private:
-        float x;
-        float y;
-        float radius;
-        float baseRadius;
-        float baseSpeedX;
-        float baseSpeedY;
-        float spin;
-        static constexpr float SPIN_DECAY = 2.0f;
-        static constexpr float MAX_SPIN = 1.0f;
-        static constexpr float SPIN_INFLUENCE = 0.3f;
+        static Playfield getPlayfield() {
+            return Playfield{VIRTUAL_WIDTH, VIRTUAL_HEIGHT, getWidthScale(), getHeightScale()};
+        }
     };
 
-    class Brick {
-    public:
-        Brick(float x, float y, float width, float height, bool isAlive);
-        void draw();
-        Rectangle getRect() const;
-        bool isAlive() const;
-        void destroy();
-        void setColor(Color c);
-        Color getColor() const { return color; }
-
-    private:
-        float x;
-        float y;
-        float width;
-        float height;
-        bool alive;
-        Color color;
-    };
+    // One compiled BrickField instantiation per game mode
+    using BrickFieldVariant = std::variant<
+        BrickField<ClassicConfig>,
+        BrickField<MegaGridConfig>,
+        BrickField<ChaosConfig>,
+        BrickField<EndlessConfig>
+    >;
 
-    Game();
+    explicit Game(GameMode mode = GameMode::CLASSIC);
     ~Game();
     void run();
     void reset();
+    void setMode(GameMode newMode);
     void initializeBricks();
     void resetBallAndPaddle();
     void updateCamera();
@@ -134,18 +83,183 @@ private:
 
     void update(float deltaTime);
     void draw();
+    void drawScene();
+    void buildRenderCommands(RenderCommandBuffer& commands) const;
+    void updateSceneTarget();
+    void updateBrickLayer();
+    void updateQuality(float frameTime);
+    void compareSoftwareRaster();
+    bool isIdleState() const;
+    void waitForInput();
+    PaddleInput readPaddleInput();
+    template <typename Config> void updatePlaying(float deltaTime);
+    void checkLevelCleared();
+    void attachBallToPaddle();
     void checkPaddleCollision();
     void checkBrickCollisions();
-    bool checkBallBrickCollision(const Rectangle& brickRect);
+    void rebuildBroadphase();
+    void updateBroadphase();
+    void logGameStart();
+    void logGameEnd();
+    void startEndless();
+    void advanceLevel();
     void validateGameObjects();
+    Rectangle getPaddleRect();
 
 private: // Added private section for camera
     Camera2D camera;
 
+    // Adaptive resolution: the scene is drawn into sceneTarget when the
+    // governor drops below native quality, then upscaled to the canvas
+    QualityGovernor governor;
+    RenderTexture2D sceneTarget;
+    // Work time of the last drawn frame: run() up to the buffer swap, less
+    // deferred tasks. Vsync hides it in the frame time.
+    double frameStart;
+    double deferredTime;
+    float lastWorkTime;
+    Profiler profiler;
+
+    // Power saving: outside PLAYING nothing moves, so frames are only drawn
+    // when something visible changed. The brick field is cached in its own
+    // layer and repainted only when a brick dies or the layout changes.
+    RenderTexture2D brickLayer;
+    bool brickLayerDirty;
+    bool needsRedraw;
+    bool skippedLastFrame;
+    int idleFramesSkipped;
+    int brickLayerRepaints;
+    static constexpr float IDLE_TICK = 0.1f;        // input polling interval while idle
+    static constexpr float MAX_FRAME_TIME = 0.05f;  // clamp for the first frame after an idle stretch
+
+    // The frame is recorded as a sorted command list and replayed by
+    // drawScene; the list is reused while nothing on screen changes
+    enum TextureSlot { SLOT_BRICK_LAYER };
+    static constexpr size_t FRAME_COMMANDS = 256;      // reserved up front; HUD, paddle, ball, overlays
+    static constexpr size_t FRAME_TEXT_BYTES = 2048;
+    RenderCommandBuffer frameCommands;
+    RenderCommandBuffer brickCommands;
+    bool renderCommandsDirty;
+    int renderCommandReuses;
+
+    // Collision categories for the broadphase
+    enum CollisionLayer : unsigned int {
+        LAYER_BALL = 1u << 0,
+        LAYER_PADDLE = 1u << 1,
+        LAYER_BRICK = 1u << 2,
+        LAYER_POWERUP = 1u << 3
+    };
+
+    // F4 compares raylib's frame with SoftwareRasterizer's. The buffers are
+    // sized on the first press and kept; the readback is capped at 4x the
+    // comparison size per axis.
+    static constexpr int RASTER_CHECK_WIDTH = 160;
+    static constexpr int RASTER_CHECK_HEIGHT = 120;
+    RenderCommandBuffer rasterCommands;
+    RenderTexture2D rasterTarget;
+    SoftwareRasterizer rasterizer;
+    std::vector<uint8_t> rasterReadback;     // RGBA, bottom-up, as GL returns it
+    std::vector<uint8_t> rasterDownsampled;  // RGBA, bottom-up, comparison size
+    std::vector<uint8_t> rasterReference;    // RGB, top-down
+    std::vector<uint8_t> rasterPixels;
+
+    // Candidate pairs from the broadphase feed the circle/rectangle narrow phase
+    SweepAndPrune broadphase;
+    int ballBody;
+    int paddleBody;
+    bool paddleCandidate;
+    std::vector<Entity> brickCandidates;
+
+    // Gameplay analytics; logging is cheap, flushes run after the frame is drawn
+    Telemetry telemetry;
+    int rallyHits;
+    uint32_t rallyStartMs;
+    uint32_t gameStartMs;
+
+    // High scores and settings; written once play stops, after the frame
+    // showing the result is drawn
+    SaveStore saves;
+    bool newHighScore;
+    void applySavedSettings();
+
+    // Endless mode: the next levels are generated and bot-validated in the
+    // background while the current one is played. Without worker threads the
+    // validation runs in slices of the main loop.
+    LevelQueue levels;
+    LevelDesign currentLevel;
+
+#ifdef BREAKOUT_FIXED_POINT
+    // Fixed-point build: FixedSimulation plays the rules and the world only
+    // mirrors its paddle, ball and bricks, scaled to the window, for drawing.
+    // It steps at TARGET_FPS on the paddle axis rounded to -1, 0 or 1, so a
+    // session replays bit-exactly from its seed and inputs.
+    FixedSimulation fixedSimulation;
+    float fixedAccumulator;
+    int fixedScore;
+    static constexpr int MAX_FIXED_STEPS = 4;  // per frame, so a stall doesn't fast-forward the ball
+    void restartFixedSimulation();
+    void updateFixedPlaying(float deltaTime);
+    void syncFixedSimulation();
+#endif
+
+    // Deferred work runs in what is left of each frame, or on idle ticks.
+    // Only the save load goes before the frame is recorded; telemetry
+    // flushes, save writes and level validation run after the previous
+    // frame's EndDrawing (FrameScheduler::runAfterDraw)
+    FrameScheduler scheduler;
+    int telemetryTask;
+    int saveLoadTask;
+    int saveWriteTask;
+    int levelTask;
+    static constexpr double IDLE_TASK_BUDGET = 0.03;   // per idle tick
+    static constexpr double LEVEL_PUMP_SLICE = 0.002;  // per played frame
+    void addDeferredTasks();
+    void requestDeferredWork();
+    void publishSchedulerStats();
+
+    // Spectator broadcast: every drawn frame is encoded into the stream.
+    // spectatorLink stands in for the socket; F5 shows a picture-in-picture
+    // spectator that joins the stream and decodes it into a render-only view.
+    SpectatorEncoder spectatorEncoder;
+    SpectatorDecoder spectatorDecoder;
+    StreamFramer spectatorLink;
+    SpectatorView spectatorView;
+    RenderCommandBuffer spectatorCommands;
+    std::vector<uint8_t> spectatorMessage;
+    std::vector<uint8_t> spectatorWire;
+    static constexpr size_t SPECTATOR_MESSAGE_BYTES = 4096;  // reserved; keyframes stay under 2 KB
+    bool spectatorVisible;
+    uint32_t spectatorTick;
+    // Per one-second window, for the profiler
+    double spectatorWindowStart;
+    uint64_t spectatorWindowBytes;
+    double spectatorWindowEncode;
+    double spectatorWindowDecode;
+    int spectatorWindowTicks;
+    char spectatorSummary[64];
+    void broadcastSpectatorFrame();
+    void drawSpectatorView();
+
+    // Tagged heap accounting (memory_tracker.h) for the overlay. Storage is
+    // reserved at startup; a new heap high while playing gets logged.
+    size_t reportedHeapPeak;
+    static constexpr size_t HEAP_GROWTH_REPORT = 4096;
+    void reserveStorage();
+    void publishMemoryStats();
+
+    // Touch drag tracking for the paddle
+    PaddleInput paddleInput;
+    bool touchActive;
+    float lastTouchX;
+
 public:
-    std::unique_ptr<Paddle> paddle;
-    std::unique_ptr<Ball> ball;
-    std::vector<std::vector<std::unique_ptr<Brick>>> bricks;
+    // Paddle, ball and bricks live in the world; systems in systems.h update
+    // and draw them
+    World world;
+    Entity paddleEntity;
+    Entity ballEntity;
+    GameMode mode;
+    BrickFieldVariant bricks;
     GameState state;
     bool gameOver;
     bool won;
@@ -155,9 +269,7 @@ public:
     int lives;
     static const int INITIAL_LIVES = 3;
     float ballSpeedTimer;
-    static constexpr float SPEED_INCREASE_INTERVAL = 5.0f;
-    static constexpr float BALL_SPEED_INCREMENT = 10.0f;
-    static constexpr float MAX_BALL_SPEED = 1000.0f;
+    static constexpr int TARGET_FPS = 60;
     
     // Method to detect and set touch device capability
     void detectTouchDevice();
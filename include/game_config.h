@@ -0,0 +1,109 @@
+#ifndef GAME_CONFIG_H
+#define GAME_CONFIG_H
+
+#include <raylib.h>
+
+// Compile-time game mode configurations. Each mode gets its own instantiation
+// of BrickField and of the PLAYING update, so grid sizes and speeds are
+// constants the compiler can fold, unroll and vectorize against.
+//
+// Brick geometry is expressed as fractions of the virtual screen:
+// BRICK_SPACING of the width, BRICK_HEIGHT and FIELD_TOP of the height.
+
+enum class GameMode {
+    CLASSIC,
+    MEGA_GRID,
+    CHAOS,
+    ENDLESS
+};
+
+constexpr int GAME_MODE_COUNT = 4;
+
+struct ClassicConfig {
+    static constexpr const char* NAME = "Classic";
+    static constexpr int ROWS = 8;
+    static constexpr int COLS = 14;
+    static constexpr float BRICK_SPACING = 0.003f;
+    static constexpr float BRICK_HEIGHT = 0.033f;
+    static constexpr float FIELD_TOP = 0.083f;
+
+    static constexpr float PADDLE_BASE_SPEED = 500.0f;
+    static constexpr float BALL_BASE_SPEED = 300.0f;
+    static constexpr float BALL_SPEED_INCREMENT = 10.0f;
+    static constexpr float SPEED_INCREASE_INTERVAL = 5.0f;
+    static constexpr float MAX_BALL_SPEED = 1000.0f;
+
+    static constexpr Color rowColor(int row) {
+        const Color colors[ROWS] = {
+            GREEN, GREEN,     // Bottom rows
+            YELLOW, YELLOW,   // Middle rows
+            ORANGE, ORANGE,   // Upper middle rows
+            RED, RED          // Top rows
+        };
+        return colors[row];
+    }
+};
+
+struct MegaGridConfig {
+    static constexpr const char* NAME = "Mega Grid";
+    static constexpr int ROWS = 16;
+    static constexpr int COLS = 28;
+    static constexpr float BRICK_SPACING = 0.002f;
+    static constexpr float BRICK_HEIGHT = 0.018f;
+    static constexpr float FIELD_TOP = 0.083f;
+
+    static constexpr float PADDLE_BASE_SPEED = 550.0f;
+    static constexpr float BALL_BASE_SPEED = 320.0f;
+    static constexpr float BALL_SPEED_INCREMENT = 8.0f;
+    static constexpr float SPEED_INCREASE_INTERVAL = 6.0f;
+    static constexpr float MAX_BALL_SPEED = 1000.0f;
+
+    static constexpr Color rowColor(int row) {
+        const Color colors[8] = { PURPLE, VIOLET, BLUE, SKYBLUE, GREEN, YELLOW, ORANGE, RED };
+        return colors[row / 2];
+    }
+};
+
+struct ChaosConfig {
+    static constexpr const char* NAME = "Chaos";
+    static constexpr int ROWS = 10;
+    static constexpr int COLS = 18;
+    static constexpr float BRICK_SPACING = 0.004f;
+    static constexpr float BRICK_HEIGHT = 0.028f;
+    static constexpr float FIELD_TOP = 0.083f;
+
+    static constexpr float PADDLE_BASE_SPEED = 600.0f;
+    static constexpr float BALL_BASE_SPEED = 400.0f;
+    static constexpr float BALL_SPEED_INCREMENT = 20.0f;
+    static constexpr float SPEED_INCREASE_INTERVAL = 3.0f;
+    static constexpr float MAX_BALL_SPEED = 1200.0f;
+
+    static constexpr Color rowColor(int row) {
+        const Color colors[5] = { MAGENTA, RED, ORANGE, YELLOW, LIME };
+        return colors[row % 5];
+    }
+};
+
+// Endless mode: levels come from LevelGenerator, which leaves gaps in this
+// grid and gives some bricks extra hit points
+struct EndlessConfig {
+    static constexpr const char* NAME = "Endless";
+    static constexpr int ROWS = 12;
+    static constexpr int COLS = 16;
+    static constexpr float BRICK_SPACING = 0.003f;
+    static constexpr float BRICK_HEIGHT = 0.03f;
+    static constexpr float FIELD_TOP = 0.083f;
+
+    static constexpr float PADDLE_BASE_SPEED = 550.0f;
+    static constexpr float BALL_BASE_SPEED = 340.0f;
+    static constexpr float BALL_SPEED_INCREMENT = 12.0f;
+    static constexpr float SPEED_INCREASE_INTERVAL = 5.0f;
+    static constexpr float MAX_BALL_SPEED = 1100.0f;
+
+    static constexpr Color rowColor(int row) {
+        const Color colors[6] = { SKYBLUE, BLUE, GREEN, YELLOW, ORANGE, RED };
+        return colors[row / 2];
+    }
+};
+
+#endif // GAME_CONFIG_H
@@ -0,0 +1,144 @@
+#ifndef LEVEL_GENERATOR_H
+#define LEVEL_GENERATOR_H
+
+#include "brick_field.h"
+#include "simulation.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Endless-mode levels.
+//
+// LevelGenerator::generate turns (seed, level number, attempt) into a
+// candidate on the EndlessConfig grid: a density curve over the rows,
+// mirrored gaps and channels, and more multi-hit bricks as the levels go on.
+// A candidate is only accepted once the headless TrackingBot has cleared it
+// within TARGET_SECONDS of game time, with up to VALIDATION_RUNS seeds; each
+// rejected attempt thins the next one out a little.
+//
+// LevelQueue keeps the next few accepted levels ready while the current one
+// is played. Workers validate attempts of the level being produced in
+// parallel and the lowest attempt that passes wins, so the sequence of levels
+// depends only on the seed, never on thread count or timing. Web builds
+// without pthreads get no workers; pump() then does the same work in slices
+// on the calling thread.
+
+struct LevelTuning {
+    static constexpr float TARGET_SECONDS = 180.0f;  // game time the bot gets to clear a level
+    static constexpr int VALIDATION_RUNS = 3;        // bot seeds tried; one clear accepts
+    static constexpr float STEP = 1.0f / 60.0f;
+    static constexpr int MIN_BRICKS = 12;
+    static constexpr int RAMP_LEVELS = 20;           // levels until full difficulty
+};
+
+class LevelGenerator {
+public:
+    static LevelDesign generate(uint32_t seed, int number, int attempt);
+};
+
+// Bot runs for one candidate, resumable so it can be spread over frames
+class LevelValidation {
+public:
+    explicit LevelValidation(const LevelDesign& level);
+
+    // Plays up to maxEvents simulation events; true once the outcome is known
+    bool advance(int maxEvents);
+    bool isDone() const { return done; }
+    bool hasPassed() const { return passed; }
+    const LevelDesign& getLevel() const { return level; }
+
+private:
+    uint32_t runSeed() const;
+
+    LevelDesign level;
+    Simulation simulation;
+    TrackingBot bot;
+    uint32_t frameLimit;
+    int run;
+    bool done;
+    bool passed;
+};
+
+class LevelQueue {
+public:
+    static constexpr int PREFETCH = 2;                 // accepted levels kept ready
+    static constexpr int MAX_ATTEMPTS_AHEAD = 8;       // attempts in flight past the first undecided one
+    static constexpr int PUMP_EVENTS = 32;             // simulation events per pump slice
+
+    struct Stats {
+        int ready;
+        int accepted;
+        int candidates;          // attempts up to and including each accepted one
+        double levelsPerSecond;  // accepted levels per second of production time
+    };
+
+    // workerCount 0 means pump() does the work
+    explicit LevelQueue(int workerCount);
+    ~LevelQueue();
+    LevelQueue(const LevelQueue&) = delete;
+    LevelQueue& operator=(const LevelQueue&) = delete;
+
+    // Hardware threads minus the main one; 0 where threads aren't available
+    static int defaultWorkerCount();
+
+    // Drops queued levels and produces from level 1 of a new seed
+    void start(uint32_t seed);
+    bool tryTake(LevelDesign& level);
+    // Waits for the next level (pumping without workers)
+    LevelDesign take();
+    // Validation work on the calling thread for up to budgetSeconds; no-op with workers
+    void pump(double budgetSeconds);
+
+    Stats getStats() const;
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        uint32_t epoch;
+        int number;
+        int attempt;
+    };
+
+    enum Outcome : int8_t { PENDING, REJECTED, ACCEPTED };
+
+    // Both with mutex held
+    bool claimJob(Job& job);
+    void finishJob(const Job& job, LevelDesign&& design, bool passed);
+    void workerLoop();
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable levelReady;
+    std::vector<std::thread> workers;
+    bool stopping;
+
+    std::deque<LevelDesign> ready;
+    uint32_t seed;
+    uint32_t epoch;
+    bool started;
+
+    // Attempts of the level being produced
+    int producingNumber;
+    int nextAttempt;
+    int firstUndecided;
+    std::vector<Outcome> outcomes;
+    std::vector<LevelDesign> candidates;
+
+    // Cooperative mode: the validation pump() is partway through
+    std::unique_ptr<LevelValidation> pumpValidation;
+    Job pumpJob;
+
+    int acceptedCount;
+    int candidateCount;
+    double productionSeconds;
+    Clock::time_point levelStartedAt;
+};
+
+#endif // LEVEL_GENERATOR_H
@@ -0,0 +1,79 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Per-subsystem heap accounting.
+//
+// Linking memory_tracker.cpp replaces the global operator new/delete with
+// versions that keep a small header in front of every block recording its
+// size and the tag that was current on the allocating thread. Subsystems set
+// the tag with a MemoryScope around the calls that allocate; blocks freed
+// later (or on another thread) are still charged back to the tag they were
+// allocated under. Without memory_tracker.cpp (the native tools) the scopes
+// compile to a thread-local store and nothing is counted.
+//
+// Only C++ allocations are seen. raylib, GLFW and libc allocate with malloc;
+// that share is reported as RAYLIB, the heap in use minus everything tagged.
+// RENDER_TARGETS is GPU memory, charged by hand when a render texture is
+// loaded or unloaded, and isn't part of the heap totals.
+
+enum class MemoryTag : uint8_t {
+    OTHER,           // untagged C++ allocations
+    BRICKS,
+    BALLS,           // paddle and ball entities
+    TEXT,            // strings in draw lists
+    DRAW_LISTS,      // render command buffers
+    RENDER_TARGETS,  // GPU, estimated
+    TELEMETRY,
+    LEVELS,
+    SAVES,
+    SPECTATOR,
+    RAYLIB,          // derived: heap in use not seen by the tracker
+    COUNT
+};
+
+constexpr int MEMORY_TAG_COUNT = static_cast<int>(MemoryTag::COUNT);
+
+inline thread_local MemoryTag currentMemoryTag = MemoryTag::OTHER;
+
+// Charges allocations made while it's alive to a tag; scopes nest
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag) : previous(currentMemoryTag) { currentMemoryTag = tag; }
+    ~MemoryScope() { currentMemoryTag = previous; }
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryTag previous;
+};
+
+class MemoryTracker {
+public:
+    struct Usage {
+        size_t current;
+        size_t peak;
+    };
+
+    static Usage getUsage(MemoryTag tag);
+    // Display names, also used as profiler stat names
+    static const char* getName(MemoryTag tag);
+
+    // Bytes handed out by malloc right now, and the heap's size (the
+    // wasm memory in the browser); both 0 where the platform can't tell
+    static size_t getHeapInUse();
+    static size_t getHeapSize();
+    // Most of the heap in use seen so far, sampled by refresh()
+    static size_t getHeapPeak();
+
+    // Recomputes the derived RAYLIB tag and the heap peak; call once a frame
+    static void refresh();
+
+    // For memory the allocator doesn't see (GPU textures)
+    static void charge(MemoryTag tag, size_t bytes);
+    static void release(MemoryTag tag, size_t bytes);
+};
+
+#endif // MEMORY_TRACKER_H
@@ -0,0 +1,20 @@
+#ifndef PERSISTENT_STORAGE_H
+#define PERSISTENT_STORAGE_H
+
+#include <string>
+
+// Location for files that must survive a reload. In the browser this is an
+// IDBFS mount backed by IndexedDB; natively it's the working directory.
+//
+// IDBFS is populated asynchronously after mount(), so callers must check
+// isReady() before touching files, and call sync() after writing to push
+// the in-memory copy back to IndexedDB (also asynchronous).
+class PersistentStorage {
+public:
+    static void mount();
+    static bool isReady();
+    static void sync();
+    static std::string pathFor(const char* fileName);
+};
+
+#endif // PERSISTENT_STORAGE_H
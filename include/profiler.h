@@ -0,0 +1,38 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <raylib.h>
+
+// On-screen profiler overlay. Subsystems publish named stats every frame and
+// log notable decisions; the overlay is toggled with F3 and drawn last so it
+// always sits on top of the scene at native resolution.
+class Profiler {
+public:
+    Profiler();
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    // Names must be string literals (they are stored by pointer)
+    void setStat(const char* name, const char* value);
+    void logEvent(const char* text);
+    void draw() const;
+
+private:
+    static constexpr int MAX_STATS = 32;
+    static constexpr int MAX_EVENTS = 6;
+    static constexpr int TEXT_LENGTH = 64;
+
+    struct Stat {
+        const char* name;
+        char value[TEXT_LENGTH];
+    };
+
+    Stat stats[MAX_STATS];
+    int statCount;
+    char events[MAX_EVENTS][TEXT_LENGTH];
+    int eventCount;
+    int nextEvent;
+    bool visible;
+};
+
+#endif // PROFILER_H
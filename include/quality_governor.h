@@ -0,0 +1,68 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+// Adaptive render quality driven by frame-time feedback.
+//
+// Two timings come in per frame. The wall-clock frame time says when frames
+// are being missed and quality must drop, but with vsync it is pinned at the
+// refresh interval whenever the frame fits, so it can't show headroom. That
+// comes from the work time: update, recording and issuing draw calls, up to
+// the buffer swap that waits for vsync.
+//
+// Level 0 renders straight into the MSAA backbuffer. Every other level renders
+// the scene into a non-multisampled offscreen target at a reduced internal
+// resolution which is then upscaled to the canvas. The window's MSAA setting
+// can't be changed after InitWindow, so going offscreen is how MSAA is dropped.
+class QualityGovernor {
+public:
+    struct Level {
+        float renderScale;
+        bool msaa;
+        const char* name;
+    };
+
+    explicit QualityGovernor(float targetFrameTime);
+
+    void addFrame(float frameSeconds, float workSeconds);
+
+    // Runs the scaling policy; returns true when the quality level changed
+    bool evaluate();
+
+    int getLevelIndex() const { return level; }
+    const Level& getLevel() const;
+    float getRenderScale() const { return getLevel().renderScale; }
+    bool usesOffscreenTarget() const { return !getLevel().msaa; }
+    float getP95FrameTime() const { return p95; }
+    float getP95WorkTime() const { return p95Work; }
+    float getBudget() const { return budget; }
+    const char* getLastDecision() const { return lastDecision; }
+
+private:
+    static constexpr int SAMPLE_WINDOW = 120;        // ~2 seconds at 60 FPS
+    static constexpr int EVALUATE_INTERVAL = 30;     // frames between decisions
+    static constexpr float DOWNGRADE_RATIO = 1.25f;  // p95 above this fraction of budget lowers quality
+    static constexpr float UPGRADE_RATIO = 1.05f;    // frame p95 must be within this fraction of budget to raise
+    static constexpr float HEADROOM_RATIO = 0.5f;    // and work p95 below this fraction of it
+    static constexpr int BASE_UPGRADE_STREAK = 6;    // headroom evaluations needed before raising quality
+    static constexpr int MAX_UPGRADE_STREAK = 96;
+    static constexpr float FLAP_WINDOW = 5.0f;       // seconds; a drop this soon after a raise backs off
+
+    float computeP95(const float* window) const;
+    void setLevel(int newLevel, const char* reason);
+
+    float budget;
+    float samples[SAMPLE_WINDOW];
+    float workSamples[SAMPLE_WINDOW];
+    int sampleCount;
+    int nextSample;
+    int framesSinceEvaluate;
+    int level;
+    int headroomStreak;
+    int requiredUpgradeStreak;
+    float timeSinceUpgrade;
+    float p95;
+    float p95Work;
+    char lastDecision[64];
+};
+
+#endif // QUALITY_GOVERNOR_H
@@ -0,0 +1,84 @@
+#ifndef RENDER_COMMANDS_H
+#define RENDER_COMMANDS_H
+
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A frame described as a flat list of draw commands instead of immediate
+// raylib calls.
+//
+// Commands are recorded in any order, then sorted by layer and primitive so
+// that rlgl sees long runs of the same texture and draw mode. Rectangles and
+// circles share the shapes texture, and text uses the font texture, so
+// interleaving them breaks the batch on every switch. Submission replays the
+// sorted list in one pass.
+//
+// Recording and sorting never touch GL state. A buffer can be filled on any
+// thread and handed over (e.g. swapped) to the thread that owns the GL
+// context. Only submit() has to run there.
+
+// Back to front; within a layer primitives are drawn in DrawPrimitive order
+enum class DrawLayer : uint8_t {
+    SCENE,     // cached brick layer, paddle, ball
+    HUD,       // score, lives, prompts
+    CONTROLS,  // touch buttons
+    MESSAGES   // pause / game over banners
+};
+
+enum class DrawPrimitive : uint8_t {
+    RENDER_TEXTURE,
+    RECTANGLE,
+    CIRCLE,
+    TEXT
+};
+
+struct RenderCommand {
+    uint64_t sortKey;  // layer, primitive, then recording order
+    float x;
+    float y;
+    float width;       // circles: radius
+    float height;      // text: font size
+    Color color;
+    uint32_t payload;  // text: offset into the string arena; textures: slot
+    DrawPrimitive primitive;
+};
+
+class RenderCommandBuffer {
+public:
+    void clear();
+    // Sizes the buffer so recording this much doesn't allocate; clear() keeps it
+    void reserve(size_t commandCount, size_t textBytes);
+
+    void addRectangle(DrawLayer layer, Rectangle rect, Color color);
+    void addCircle(DrawLayer layer, Vector2 center, float radius, Color color);
+    // The text is copied, so temporary buffers are fine
+    void addText(DrawLayer layer, const char* text, float x, float y, float fontSize, Color color);
+    // Slot indexes the texture array passed to submit(). Render textures are
+    // stored upside down, so the source is flipped when drawn.
+    void addRenderTexture(DrawLayer layer, int slot, Rectangle dest, Color tint);
+
+    // Orders commands for submission; stable within a layer/primitive group
+    void sort();
+
+    // Replays the commands; must run on the GL thread inside a drawing block
+    void submit(const Texture2D* textureSlots) const;
+
+    void swap(RenderCommandBuffer& other);
+
+    size_t size() const { return commands.size(); }
+    bool isSorted() const { return sorted; }
+    // Number of primitive switches submit() will make, a proxy for rlgl batch breaks
+    int getPrimitiveSwitches() const;
+
+private:
+    void push(DrawLayer layer, DrawPrimitive primitive, float x, float y, float width, float height,
+              Color color, uint32_t payload);
+
+    std::vector<RenderCommand> commands;
+    std::vector<char> strings;
+    bool sorted = true;
+};
+
+#endif // RENDER_COMMANDS_H
@@ -0,0 +1,90 @@
+#ifndef ROTATION_TABLES_H
+#define ROTATION_TABLES_H
+
+#include <array>
+#include <cstdint>
+
+// Rotations used by collision response:
+//   DEFLECTION    straight up rotated by the paddle deflection, one entry per
+//                 hit offset step in [-PADDLE_HIT_RANGE, PADDLE_HIT_RANGE];
+//                 60 degrees at the paddle edge
+//   PERTURBATION  small (cos, sin) rotations of up to 5 degrees for brick
+//                 corner hits
+//
+// Generated at compile time with 2.30 integer arithmetic (Taylor series),
+// so the float and fixed-point physics get the same table bits on every
+// target instead of whatever the platform's libm returns.
+
+// 2.30 integer trig used to build the tables
+struct RotationMath {
+    static constexpr int64_t ONE = 1ll << 30;
+    static constexpr int64_t PI_2_30 = 3373259426ll;  // round(pi * 2^30)
+
+    // Unit vector in 2.30
+    struct Rotation {
+        int64_t x;
+        int64_t y;
+    };
+
+    static constexpr int64_t multiply(int64_t a, int64_t b) { return a * b / ONE; }
+
+    // Both for |angle| <= pi/2, terms up to x^15
+    static constexpr int64_t sine(int64_t angle) {
+        int64_t term = angle;
+        int64_t sum = angle;
+        for (int k = 1; k <= 7; k++) {
+            term = -multiply(multiply(term, angle), angle) / ((2 * k) * (2 * k + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static constexpr int64_t cosine(int64_t angle) {
+        int64_t term = ONE;
+        int64_t sum = ONE;
+        for (int k = 1; k <= 7; k++) {
+            term = -multiply(multiply(term, angle), angle) / ((2 * k - 1) * (2 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    template <int STEPS>
+    static constexpr std::array<Rotation, STEPS> generateDeflection() {
+        std::array<Rotation, STEPS> table{};
+        for (int i = 0; i < STEPS; i++) {
+            // hit = -1.5 + 3 * i / (STEPS - 1), angle = hit * pi / 3
+            int64_t hit = -3 * ONE / 2 + 3 * ONE * i / (STEPS - 1);
+            int64_t angle = multiply(hit, PI_2_30 / 3);
+            table[i] = Rotation{ sine(angle), -cosine(angle) };
+        }
+        return table;
+    }
+
+    template <int STEPS>
+    static constexpr std::array<Rotation, STEPS> generatePerturbation() {
+        std::array<Rotation, STEPS> table{};
+        const int64_t maxAngle = PI_2_30 / 36;  // 5 degrees
+        for (int i = 0; i < STEPS; i++) {
+            int64_t angle = -maxAngle + 2 * maxAngle * i / (STEPS - 1);
+            table[i] = Rotation{ cosine(angle), sine(angle) };
+        }
+        return table;
+    }
+};
+
+struct RotationTables {
+    using Rotation = RotationMath::Rotation;
+    static constexpr int64_t ONE = RotationMath::ONE;
+
+    static constexpr int DEFLECTION_STEPS = 257;
+    static constexpr float PADDLE_HIT_RANGE = 1.5f;  // hit offsets beyond the paddle edge are clamped
+    static constexpr int PERTURBATION_STEPS = 33;
+
+    static constexpr std::array<Rotation, DEFLECTION_STEPS> DEFLECTION =
+        RotationMath::generateDeflection<DEFLECTION_STEPS>();
+    static constexpr std::array<Rotation, PERTURBATION_STEPS> PERTURBATION =
+        RotationMath::generatePerturbation<PERTURBATION_STEPS>();
+};
+
+#endif // ROTATION_TABLES_H
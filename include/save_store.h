@@ -0,0 +1,88 @@
+#ifndef SAVE_STORE_H
+#define SAVE_STORE_H
+
+#include "game_config.h"
+#include <cstdint>
+#include <string>
+
+// High scores and settings that survive a reload.
+//
+// Everything lives in one small SaveData block in PersistentStorage (IDBFS in
+// the browser, a plain file natively). Nothing here touches storage from
+// Game::update or draw:
+//   - poll() loads the file once storage reports ready. IDBFS populates
+//     asynchronously, so the first frames run on defaults; anything recorded
+//     before the load is merged into what was loaded, and settings changed
+//     before it win over the stored ones.
+//   - recordGame() and the setters only change memory and mark it dirty.
+//   - flush() writes the block to a temporary file and renames it over the
+//     old one only if every write succeeded, then starts the asynchronous
+//     IndexedDB sync. A failed write keeps the old file and stays pending.
+//     Game requests it only once play has stopped and runs it after draw
+//     (FrameScheduler::runAfterDraw), so the GAME_OVER/WON frame is on
+//     screen before the write starts.
+//
+// File layout (little endian):
+//   "BKSV" | u16 version | u16 payload size | SaveData | u32 FNV-1a of SaveData
+// A file with the wrong version, size or checksum is ignored.
+
+struct SaveData {
+    static constexpr int TOP_SCORES = 5;
+
+    int32_t topScores[GAME_MODE_COUNT][TOP_SCORES];  // descending, 0 = empty
+    int32_t bestLevel;                               // endless mode
+    uint32_t gamesPlayed;
+    uint8_t mode;                                    // last selected GameMode
+    uint8_t profilerVisible;
+    uint8_t reserved[2];
+};
+static_assert(sizeof(SaveData) % 4 == 0, "save data must stay padding-free");
+
+class SaveStore {
+public:
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    explicit SaveStore(const char* fileName);
+
+    // Loads once storage is ready; true on the call that loaded
+    bool poll();
+    bool isLoaded() const { return loaded; }
+    // The load found a file with the wrong version, size or checksum and
+    // kept the defaults; the next write replaces it
+    bool ignoredUnreadableFile() const { return ignoredFile; }
+    const SaveData& getData() const { return data; }
+    int getBestScore(GameMode mode) const { return data.topScores[static_cast<int>(mode)][0]; }
+
+    // Memory only. Returns true if the score made the mode's top list.
+    bool recordGame(GameMode mode, int score, int level);
+    void setMode(GameMode mode);
+    void setProfilerVisible(bool visible);
+
+    bool hasPendingWrite() const { return dirty && loaded; }
+    // Writes pending changes; call from idle time, never update or draw
+    void flush();
+    uint32_t getWrites() const { return writes; }
+    uint32_t getFailedWrites() const { return failedWrites; }
+
+private:
+    static void insertScore(int32_t (&scores)[SaveData::TOP_SCORES], int32_t score);
+    void merge(const SaveData& loadedData);
+
+    // Settings changed in memory since startup, which merge() keeps
+    enum ChangedSetting : uint8_t {
+        SETTING_MODE = 1u << 0,
+        SETTING_PROFILER = 1u << 1
+    };
+
+    std::string path;
+    std::string temporaryPath;
+    SaveData data;
+    bool loaded;
+    bool ignoredFile;
+    bool dirty;
+    uint8_t changedSettings;
+    uint32_t writes;
+    uint32_t failedWrites;
+};
+
+#endif // SAVE_STORE_H
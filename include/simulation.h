@@ -0,0 +1,175 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "brick_field.h"
+#include "broadphase.h"
+#include "ecs.h"
+#include "game_config.h"
+#include "systems.h"
+#include <cstdint>
+#include <vector>
+
+// Headless fixed-step simulation for bots, recorded sessions and regression
+// runs, on its own World without a window. Walls, speed-ups, paddle and brick
+// response and life loss go through the same systems.h functions
+// Game::updatePlaying calls, but the ball is moved differently: the game
+// accumulates its position every frame in movementSystem, the simulation
+// evaluates it in closed form (below). The two agree to about 2e-3 px over a
+// segment, but a contact one of them reaches a frame earlier sends the
+// sessions apart, so a simulated session is not a replay of a game session;
+// replays go through FixedSimulation, which steps exactly as the
+// BREAKOUT_FIXED_POINT game does. tools/step_drift_check.cpp measures how
+// long a whole session of this one stays with the real systems.
+//
+// There are two ways to advance it:
+//   step()        runs one fixed frame, like the game loop
+//   fastForward() finds the next frame on which anything can happen (a wall,
+//                 brick or paddle contact, a speed-up) and jumps straight to it
+//
+// Between events the ball only moves, so its position is evaluated in closed
+// form from the state at the last event rather than accumulated frame by
+// frame. Both paths use that formula and the same per-frame event code, so a
+// fast-forwarded run lands on exactly the state step() reaches.
+//
+// Other differences from the interactive game: the step is fixed, the
+// playfield size is fixed, and the ball launches as soon as it is served.
+
+class Simulation;
+
+// Drives the paddle. axis() is called for every frame, including the ones
+// fastForward skips, so it may only depend on the frame and the paddle.
+// onEvent() sees the full state after every frame that had an event, and is
+// where a bot makes its decisions.
+class PaddleController {
+public:
+    virtual ~PaddleController() = default;
+    virtual void onEvent(const Simulation& simulation) { (void)simulation; }
+    virtual float axis(uint32_t frame, float paddleX) = 0;
+};
+
+// Bits returned by step() and fastForward()
+enum SimulationEvent : uint32_t {
+    SIM_EVENT_WALL = 1u << 0,
+    SIM_EVENT_SPEED_UP = 1u << 1,
+    SIM_EVENT_PADDLE = 1u << 2,
+    SIM_EVENT_BRICK = 1u << 3,
+    SIM_EVENT_LIFE_LOST = 1u << 4
+};
+
+class Simulation {
+public:
+    static constexpr int INITIAL_LIVES = 3;
+
+    Simulation(GameMode mode, float stepSeconds, uint32_t seed);
+    // Plays a generated level instead of the mode's full grid
+    Simulation(const LevelDesign& level, float stepSeconds, uint32_t seed);
+    void reset(uint32_t seed);
+
+    // One frame; returns the events that happened in it
+    uint32_t step(PaddleController& controller);
+    // Advances up to maxFrames, stopping after the first frame with an event.
+    // Returns that frame's events, or 0 if the limit or the end came first.
+    uint32_t fastForward(PaddleController& controller, uint32_t maxFrames);
+
+    bool isOver() const { return lives <= 0 || bricksLeft == 0; }
+    bool isWon() const { return bricksLeft == 0; }
+    uint32_t getFrame() const { return frame; }
+    float getStep() const { return stepSeconds; }
+    int getScore() const { return score; }
+    int getLives() const { return lives; }
+    int getBricksLeft() const { return bricksLeft; }
+    const Playfield& getPlayfield() const { return playfield; }
+    // Current after step(); fastForward only writes the ball on event frames
+    const World& getWorld() const { return world; }
+
+    Vector2 getBallPosition() const { return ballPositionAt(frame); }
+    Velocity getBallVelocity() const;
+    float getBallRadius() const;
+    Rectangle getPaddleRect() const;
+
+    // Where the ball will be on a later frame if nothing hits it first
+    Vector2 ballPositionAt(uint32_t atFrame) const;
+    // First frame the falling ball reaches the paddle's top edge in its
+    // current straight line; UINT32_MAX if it is rising
+    uint32_t predictPaddleLineFrame() const;
+
+    // FNV-1a over frame, score, lives, ball, paddle and surviving bricks
+    uint64_t stateHash() const;
+
+private:
+    // Ball state at the last event; positions on later frames are derived from it
+    struct BallSegment {
+        uint32_t frame;
+        float x;
+        float y;
+        float dirX;
+        float dirY;
+        float speed;
+        float spin;
+    };
+
+    struct Tuning {
+        float paddleSpeed;
+        float ballSpeed;
+        float speedIncrement;
+        float maxSpeed;
+        uint32_t speedUpFrames;
+    };
+
+    template <typename Config> void setup();
+    void serve();
+    void rebase();
+    float spinAfter(uint32_t frames) const;
+    float spinSumAfter(uint32_t frames) const;
+    Vector2 segmentPosition(uint32_t frames) const;
+
+    void movePaddle(PaddleController& controller);
+    uint32_t resolveFrame();
+    uint32_t nextEventFrame(uint32_t limit) const;
+    uint32_t nextRandom();
+
+    GameMode mode;
+    LevelDesign level;  // no hit points: the full grid
+    float stepSeconds;
+    Playfield playfield;
+    Tuning tuning;
+
+    World world;
+    Entity paddle;
+    Entity ball;
+    SweepAndPrune broadphase;
+    int ballBody;
+    int paddleBody;
+    std::vector<Entity> brickCandidates;
+
+    BallSegment segment;
+    float paddleAxis;
+    uint32_t frame;
+    uint32_t lastSpeedUpFrame;
+    uint32_t rngState;
+    int score;
+    int lives;
+    int bricksLeft;
+};
+
+// Steers towards where the ball will cross the paddle line, aiming off
+// centre by a random amount so rallies vary. Decisions are only made on
+// events, so the bot is valid for fastForward.
+class TrackingBot : public PaddleController {
+public:
+    explicit TrackingBot(uint32_t seed);
+
+    void onEvent(const Simulation& simulation) override;
+    float axis(uint32_t frame, float paddleX) override;
+
+private:
+    static constexpr float DEAD_ZONE = 10.0f;
+
+    uint32_t next();
+
+    uint32_t rng;
+    float target;
+    float paddleWidth;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,84 @@
+#ifndef SOFTWARE_RASTER_H
+#define SOFTWARE_RASTER_H
+
+#include <raylib.h>
+#include "ecs.h"
+#include "fixed_simulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU rasterizer for small observation frames (84x84 gray, 160x120 RGB, ...)
+// with no GPU or GL context, for pixel-based agents and visual regression
+// checks.
+//
+// Draws the same scene as Game::drawScene minus the HUD: bricks, paddle and
+// ball on black. Every pixel gets the exact area its primitives cover, so a
+// frame matches what raylib draws at full resolution box-filtered down to
+// the target size. Edges are the only partly covered pixels; the interior of
+// every span is filled or blended 16 pixels at a time with vector code.
+//
+// renderSimulation keeps the brick field in a cached layer and redraws it
+// only after a brick dies, the same way Game caches its brick layer, so most
+// frames are a copy plus a paddle and a ball. One rasterizer per instance;
+// BreakoutEnv renders whole batches on its thread pool.
+class SoftwareRasterizer {
+public:
+    enum class Format { LUMINANCE = 1, RGB = 3 };
+
+    struct Difference {
+        double meanError;      // per channel byte, 0-255
+        int maxError;
+        double withinTolerance;  // fraction of bytes
+    };
+
+    SoftwareRasterizer(int width, int height, Format format, float sourceWidth, float sourceHeight);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChannels() const { return channels; }
+    size_t getFrameSize() const { return static_cast<size_t>(width) * height * channels; }
+    // For a source that was resized; drops the cached brick layer
+    void setSourceSize(float sourceWidth, float sourceHeight);
+
+    // Primitives in source coordinates
+    void clear(uint8_t* pixels, Color color) const;
+    void fillRect(uint8_t* pixels, Rectangle rect, Color color) const;
+    void fillCircle(uint8_t* pixels, Vector2 center, float radius, Color color) const;
+    // Adds coverage instead of blending over, for shapes that never overlap
+    // drawn onto black: a pixel shared by two bricks gets both exactly
+    void addRect(uint8_t* pixels, Rectangle rect, Color color) const;
+
+    void renderWorld(const World& world, uint8_t* pixels) const;
+    void renderSimulation(const FixedSimulation& simulation, uint8_t* pixels);
+
+    // Area-weighted downscale of an 8-bit image with the given channel count
+    static void downsample(const uint8_t* source, int sourceWidth, int sourceHeight, int channels,
+                           uint8_t* target, int targetWidth, int targetHeight);
+    static Difference compare(const uint8_t* a, const uint8_t* b, size_t bytes, int tolerance);
+
+private:
+    enum class Blend { OVER, ADD };
+
+    // A color repeated over 16 pixels (16 bytes gray, 48 RGB)
+    struct Pattern {
+        uint8_t bytes[48];
+    };
+
+    Pattern makePattern(Color color) const;
+    void drawRect(uint8_t* pixels, Rectangle rect, Color color, Blend blend) const;
+    // alpha 0-256 over count pixels starting at column first
+    void blendSpan(uint8_t* row, int first, int count, const Pattern& pattern, int alpha, Blend blend) const;
+    void blendPixel(uint8_t* row, int column, const Pattern& pattern, int alpha, Blend blend) const;
+
+    int width;
+    int height;
+    int channels;
+    float scaleX;
+    float scaleY;
+
+    std::vector<uint8_t> brickLayer;
+    std::vector<uint64_t> brickLayerAlive;  // bricks the cached layer shows
+};
+
+#endif // SOFTWARE_RASTER_H
@@ -0,0 +1,136 @@
+#ifndef SPECTATOR_STREAM_H
+#define SPECTATOR_STREAM_H
+
+#include <raylib.h>
+#include "ecs.h"
+#include "game_config.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Live game broadcast for spectators and coaching tools.
+//
+// The stream is one message per tick. A keyframe carries everything a viewer
+// needs to start from nothing: mode, playfield, HUD numbers, the level's
+// brick layout and which bricks are alive, paddle and ball. A delta carries
+// only what changed since the previous tick: paddle x, the ball, the bricks
+// that flipped and the HUD numbers. Positions are quantized to 1/8 pixel and
+// the ball is coded as the error of a constant-velocity prediction, so a
+// ball in flight costs nothing until it bounces. Integers are zigzag varints
+// and a flags byte says which fields follow.
+//
+// Keyframes go out every KEYFRAME_INTERVAL ticks, whenever the field is
+// rebuilt (new game, mode switch, next endless level) and on request, so a
+// late joiner waits at most that long and a lost delta heals.
+//
+// Transport is a byte stream of varint-length-prefixed messages (frameMessage
+// and StreamFramer), which is what a TCP socket or a WebSocket carries.
+
+struct SpectatorState {
+    uint32_t tick;
+    GameMode mode;
+    uint8_t phase;       // the broadcaster's game state (start screen, playing, ...)
+    int32_t score;
+    int32_t lives;
+    int32_t level;       // endless level number, 0 otherwise
+    float width;         // playfield
+    float height;
+    std::vector<uint8_t> layout;   // hit points each cell was spawned with, 0 for empty cells
+    std::vector<uint64_t> alive;   // bitmask over cells, 64 per word
+    Rectangle paddle;
+    Vector2 ball;
+    float ballRadius;
+};
+
+// Fills the geometry and brick fields from a World. mode must be set; layout
+// is the level's design (empty for a full grid of single-hit bricks).
+void captureSpectatorState(const World& world, const std::vector<uint8_t>& layout, SpectatorState& state);
+
+int spectatorCellCount(GameMode mode);
+
+// Values as both ends see them after a message; the encoder codes against
+// this and the decoder rebuilds it, so they never drift apart
+struct SpectatorModel {
+    bool valid;
+    uint32_t tick;
+    uint8_t mode;
+    uint8_t phase;
+    int32_t score;
+    int32_t lives;
+    int32_t level;
+    int32_t width;
+    int32_t height;
+    std::vector<uint8_t> layout;
+    std::vector<uint64_t> alive;
+    int32_t paddleX;
+    int32_t paddleY;
+    int32_t paddleWidth;
+    int32_t paddleHeight;
+    int32_t ballX;
+    int32_t ballY;
+    int32_t previousBallX;
+    int32_t previousBallY;
+    int32_t ballRadius;
+};
+
+class SpectatorEncoder {
+public:
+    static constexpr uint32_t KEYFRAME_INTERVAL = 120;  // ticks, 2 s at 60 FPS
+
+    SpectatorEncoder();
+
+    // Appends one message for this tick (unframed)
+    void encode(const SpectatorState& state, std::vector<uint8_t>& message);
+    void requestKeyframe() { keyframeRequested = true; }
+
+    uint64_t getMessages() const { return messages; }
+    uint64_t getKeyframes() const { return keyframes; }
+    uint64_t getBytes() const { return bytes; }
+
+private:
+    bool needsKeyframe(const SpectatorModel& next) const;
+
+    SpectatorModel model;
+    // Scratch reused across encode calls so steady-state frames don't allocate
+    SpectatorModel next;
+    std::vector<int> flipped;
+    uint32_t lastKeyframeTick;
+    bool keyframeRequested;
+    uint64_t messages;
+    uint64_t keyframes;
+    uint64_t bytes;
+};
+
+class SpectatorDecoder {
+public:
+    SpectatorDecoder();
+
+    // False for a malformed message or a delta before the first keyframe;
+    // the state is left as it was
+    bool decode(const uint8_t* data, size_t size);
+    bool hasState() const { return model.valid; }
+    // Valid after a successful decode
+    const SpectatorState& getState() const { return state; }
+
+private:
+    SpectatorModel model;
+    SpectatorModel next;  // reused decode scratch
+    SpectatorState state;
+};
+
+// Length-prefixed messages over a byte stream
+void frameMessage(const std::vector<uint8_t>& message, std::vector<uint8_t>& out);
+
+class StreamFramer {
+public:
+    void feed(const uint8_t* data, size_t size);
+    // Pops the next complete message
+    bool next(std::vector<uint8_t>& message);
+    size_t getBuffered() const { return buffer.size() - readOffset; }
+
+private:
+    std::vector<uint8_t> buffer;
+    size_t readOffset = 0;
+};
+
+#endif // SPECTATOR_STREAM_H
@@ -0,0 +1,37 @@
+#ifndef SPECTATOR_VIEW_H
+#define SPECTATOR_VIEW_H
+
+#include "ecs.h"
+#include "render_commands.h"
+#include "spectator_stream.h"
+#include <vector>
+
+// Render-only game driven by a spectator stream: a World holding the
+// broadcast bricks, paddle and ball, with no rules of its own. The field is
+// respawned from the keyframe layout when it changes and bricks are removed
+// as the deltas report them, so drawing goes through the same renderSystem
+// as the live game.
+class SpectatorView {
+public:
+    SpectatorView();
+
+    void apply(const SpectatorState& next);
+    bool hasState() const { return valid; }
+    const SpectatorState& getState() const { return state; }
+    const World& getWorld() const { return world; }
+
+    // Bricks, paddle and ball in the broadcaster's playfield coordinates
+    void buildRenderCommands(RenderCommandBuffer& commands) const;
+
+private:
+    void rebuild(const SpectatorState& next);
+
+    World world;
+    Entity paddle;
+    Entity ball;
+    std::vector<Entity> cells;  // brick per grid cell, NULL_ENTITY once gone
+    SpectatorState state;
+    bool valid;
+};
+
+#endif // SPECTATOR_VIEW_H
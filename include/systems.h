@@ -0,0 +1,101 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include "ecs.h"
+#include "render_commands.h"
+#include <algorithm>
+
+// Systems operating on the World. Everything here is pure simulation and
+// makes no raylib calls, so it can run headless; renderSystem only records
+// draw commands.
+
+// Screen the simulation is laid out on, with scale factors relative to the
+// 800x600 base resolution speeds and sizes are tuned for
+struct Playfield {
+    float width;
+    float height;
+    float widthScale;
+    float heightScale;
+};
+
+// Per-frame paddle input, already resolved from keyboard/touch
+struct PaddleInput {
+    float axis;       // -1 left, 0 none, 1 right
+    float dragDelta;  // horizontal touch drag in pixels since last frame
+};
+
+// Sizes are at the 800x600 base resolution
+struct PaddleTuning {
+    static constexpr float BASE_WIDTH = 100.0f;
+    static constexpr float BASE_HEIGHT = 19.8f;
+    static constexpr float Y_FRACTION = 0.9f;  // top edge, fraction of the screen height
+};
+
+struct BallTuning {
+    static constexpr float BASE_RADIUS = 10.0f;
+    static constexpr float SPIN_DECAY = 2.0f;
+    static constexpr float MAX_SPIN = 1.0f;
+    static constexpr float SPIN_INFLUENCE = 0.3f;
+};
+
+inline void addSpin(Velocity& velocity, float spinValue) {
+    velocity.spin = std::clamp(velocity.spin + spinValue, -BallTuning::MAX_SPIN, BallTuning::MAX_SPIN);
+}
+
+// d' = d - 2(d.n)n; length is preserved for a unit normal
+inline void reflect(Velocity& velocity, Vector2 normal) {
+    float dot = velocity.dirX * normal.x + velocity.dirY * normal.y;
+    velocity.dirX -= 2.0f * dot * normal.x;
+    velocity.dirY -= 2.0f * dot * normal.y;
+}
+
+// Matches the old per-component speed increment to first order:
+// |(|vx| + i, |vy| + i)| ~= speed + i * (|dx| + |dy|)
+inline void increaseSpeed(Velocity& velocity, float increment, float maxSpeed) {
+    float gain = increment * ((velocity.dirX < 0 ? -velocity.dirX : velocity.dirX) +
+                              (velocity.dirY < 0 ? -velocity.dirY : velocity.dirY));
+    velocity.speed = std::min(velocity.speed + gain, maxSpeed);
+}
+
+// Circle/rectangle overlap, edges inclusive like CheckCollisionCircleRec
+inline bool circleOverlapsRect(Vector2 center, float radius, const Rectangle& rect) {
+    float closestX = std::min(std::max(center.x, rect.x), rect.x + rect.width);
+    float closestY = std::min(std::max(center.y, rect.y), rect.y + rect.height);
+    float dx = center.x - closestX;
+    float dy = center.y - closestY;
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+inline Rectangle boxBounds(const Position& position, const Collider& collider) {
+    return Rectangle{position.x, position.y, collider.width, collider.height};
+}
+
+inline Rectangle circleBounds(const Position& position, const Collider& collider) {
+    return Rectangle{position.x - collider.radius, position.y - collider.radius,
+                     collider.radius * 2.0f, collider.radius * 2.0f};
+}
+
+// Both start at base size; run resizeSystem afterwards for other resolutions.
+// The ball rests on the paddle's top edge.
+Entity spawnPaddle(World& world, const Playfield& playfield, float speed);
+Entity spawnBall(World& world, const Playfield& playfield, float speed);
+
+void paddleInputSystem(World& world, const PaddleInput& input);
+void movementSystem(World& world, float deltaTime, const Playfield& playfield);
+void containmentSystem(World& world, const Playfield& playfield);
+void resizeSystem(World& world, const Playfield& playfield);
+void renderSystem(const World& world, RenderLayer layer, DrawLayer drawLayer, RenderCommandBuffer& commands);
+
+// Side and top edge bounce for one ball; true if it touched a wall
+bool bounceOffWalls(Position& ball, Velocity& velocity, const Collider& collider, const Playfield& playfield);
+
+// Collision response for one ball. Both return false when there's no
+// contact, leave the speed untouched and only rotate or reflect the direction.
+// random picks the small rotation applied on brick corner hits, so callers
+// control determinism.
+bool resolveBallPaddle(Position& ball, Velocity& velocity, const Collider& collider,
+                       const Rectangle& paddle, float paddleAxis, float& hitOffset);
+bool resolveBallBrick(Position& ball, Velocity& velocity, const Collider& collider,
+                      const Rectangle& brick, uint32_t random);
+
+#endif // SYSTEMS_H
@@ -0,0 +1,103 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// Gameplay telemetry log.
+//
+// Events are fixed-size 16 byte records written into a preallocated ring
+// buffer, so logging from the collision code is a handful of stores. The ring
+// is flushed in batches after the frame that logged them has been drawn
+// (FrameScheduler::runAfterDraw), appending to a file in PersistentStorage (IDBFS in the browser).
+//
+// The file is a sequence of chunks, appended by every flush (little endian):
+//   schema: "BKTS" | u16 version | u16 record size | u32 schema id | u8 type count
+//           per type: u8 id, then name and field names a/b/c as u8 length + chars
+//   batch:  "BKTB" | u16 version | u16 record size | u32 schema id | u32 record count
+//           records
+// A schema chunk is written before the first batch of every session, so a
+// build with different event types appending to an older file leaves each
+// batch tagged with the schema it was written under. The schema id is a hash
+// of the schema chunk's contents. tools/telemetry_reader.cpp decodes it using
+// only the embedded schemas, and skips batches whose schema it hasn't seen.
+// A file from before the chunked format is moved aside to <name>.v1.
+
+// Values are stored in files; never renumber
+enum class TelemetryEventType : uint8_t {
+    GAME_START = 1,  // a: mode
+    GAME_END = 2,    // a: won, b: score, c: duration ms
+    BRICK_HIT = 3,   // a: brick index, b: ball x, c: ball y
+    PADDLE_HIT = 4,  // a: hits this rally, b: offset from paddle centre (per mille)
+    LIFE_LOST = 5,   // a: lives left, b: ball x
+    RALLY_END = 6    // a: paddle hits, b: duration ms
+};
+
+struct TelemetryRecord {
+    uint32_t timeMs;
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t a;
+    int32_t b;
+    int32_t c;
+};
+static_assert(sizeof(TelemetryRecord) == 16, "telemetry records must stay 16 bytes");
+
+class Telemetry {
+public:
+    static constexpr uint32_t CAPACITY = 4096;  // power of two, 64 KB
+    static constexpr uint32_t FLUSH_THRESHOLD = CAPACITY / 4;
+    static constexpr uint16_t FORMAT_VERSION = 2;
+
+    explicit Telemetry(const char* fileName);
+
+    // Sets the timestamp for subsequent events; call once per frame
+    void setClock(double seconds) { nowMs = static_cast<uint32_t>(seconds * 1000.0); }
+    uint32_t getClockMs() const { return nowMs; }
+
+    // Hot path: no allocation, no I/O. Drops the event if the ring is full.
+    void log(TelemetryEventType type, uint16_t a = 0, int32_t b = 0, int32_t c = 0) {
+        if (head - tail == CAPACITY) {
+            dropped++;
+            return;
+        }
+        TelemetryRecord& record = ring[head & (CAPACITY - 1)];
+        record.timeMs = nowMs;
+        record.type = static_cast<uint8_t>(type);
+        record.reserved = 0;
+        record.a = a;
+        record.b = b;
+        record.c = c;
+        head++;
+    }
+
+    bool shouldFlush() const { return head - tail >= FLUSH_THRESHOLD; }
+    uint32_t getPending() const { return head - tail; }
+    uint32_t getDropped() const { return dropped; }
+    uint32_t getWritten() const { return written; }
+    uint32_t getFailedWrites() const { return failedWrites; }
+
+    // Appends every pending record to the log file. Leaves them queued if
+    // storage isn't ready yet (IDBFS still loading) or the write fails.
+    void flush();
+
+private:
+    // Opens the log for appending, moving aside a file in the old format
+    FILE* openLog();
+
+    std::unique_ptr<TelemetryRecord[]> ring;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t nowMs;
+    uint32_t dropped;
+    uint32_t written;
+    uint32_t failedWrites;
+    std::string path;
+    std::string schemaChunk;
+    uint32_t schemaId;
+    bool schemaWritten;
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,271 @@
+#include "../include/breakout_env.h"
+#include "../include/fixed_simulation.h"
+#include "../include/software_raster.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The C handle. Workers sleep between calls and are woken by a generation
+// counter; each owns the same contiguous range of games every call, so a
+// game's state stays in one core's cache.
+struct BreakoutEnv {
+    enum class Operation { STEP, RESET, RENDER };
+
+    struct Batch {
+        Operation operation;
+        const int8_t* actions;
+        float* observations;
+        uint64_t* bricks;
+        float* rewards;
+        uint8_t* dones;
+        uint8_t* pixels;
+    };
+
+    BreakoutEnvConfig config;
+    std::vector<FixedSimulation> games;
+    std::vector<uint32_t> seedStates;  // per game, draws the next episode's seed
+    std::vector<SoftwareRasterizer> rasterizers;  // per game, empty until breakout_env_set_pixels
+    int brickWords;
+    int threadCount;
+    float inverseWidth;
+    float inverseHeight;
+
+    Batch batch;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable batchStarted;
+    std::condition_variable batchFinished;
+    uint64_t generation;
+    int busyWorkers;
+    bool stopping;
+
+    void runRange(int thread);
+    void runBatch(const Batch& next);
+    void workerLoop(int thread);
+    void writeObservation(int index);
+    uint32_t nextSeed(int index);
+};
+
+uint32_t BreakoutEnv::nextSeed(int index) {
+    uint32_t& state = seedStates[index];
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+void BreakoutEnv::writeObservation(int index) {
+    const FixedSimulation& game = games[index];
+    if (batch.observations) {
+        const FixedVector position = game.getBallPosition();
+        const FixedVector direction = game.getBallDirection();
+        const Fixed speed = game.getBallSpeed();
+        float* out = batch.observations + static_cast<size_t>(index) * BREAKOUT_ENV_STATE_SIZE;
+        out[BREAKOUT_ENV_PADDLE_X] = (game.getPaddleX() + game.getPaddleWidth().half()).toFloat() * inverseWidth;
+        out[BREAKOUT_ENV_BALL_X] = position.x.toFloat() * inverseWidth;
+        out[BREAKOUT_ENV_BALL_Y] = position.y.toFloat() * inverseHeight;
+        out[BREAKOUT_ENV_BALL_VX] = (direction.x * speed).toFloat() * inverseWidth;
+        out[BREAKOUT_ENV_BALL_VY] = (direction.y * speed).toFloat() * inverseHeight;
+        out[BREAKOUT_ENV_BALL_SPIN] = game.getBallSpin().toFloat();
+    }
+    if (batch.bricks) {
+        const std::vector<uint64_t>& alive = game.getBrickAlive();
+        std::copy(alive.begin(), alive.end(), batch.bricks + static_cast<size_t>(index) * brickWords);
+    }
+}
+
+void BreakoutEnv::runRange(int thread) {
+    const int count = static_cast<int>(games.size());
+    const int begin = static_cast<int>(static_cast<int64_t>(count) * thread / threadCount);
+    const int end = static_cast<int>(static_cast<int64_t>(count) * (thread + 1) / threadCount);
+
+    for (int i = begin; i < end; i++) {
+        FixedSimulation& game = games[i];
+        if (batch.operation == Operation::RENDER) {
+            SoftwareRasterizer& rasterizer = rasterizers[i];
+            rasterizer.renderSimulation(game, batch.pixels + rasterizer.getFrameSize() * i);
+            continue;
+        }
+        if (batch.operation == Operation::RESET) {
+            game.reset(nextSeed(i));
+            writeObservation(i);
+            continue;
+        }
+
+        const int axis = std::max(-1, std::min(1, static_cast<int>(batch.actions[i])));
+        const int bricksBefore = game.getBricksLeft();
+        const int livesBefore = game.getLives();
+        for (int frame = 0; frame < config.frames_per_step && !game.isOver(); frame++) {
+            game.step(axis);
+        }
+
+        uint8_t done = 0;
+        if (game.isOver()) {
+            done = BREAKOUT_ENV_TERMINATED | (game.isWon() ? BREAKOUT_ENV_WON : 0);
+        } else if (config.max_frames != 0 && game.getFrame() >= config.max_frames) {
+            done = BREAKOUT_ENV_TRUNCATED;
+        }
+        if (batch.rewards) {
+            batch.rewards[i] = static_cast<float>(bricksBefore - game.getBricksLeft()) -
+                               config.life_penalty * static_cast<float>(livesBefore - game.getLives());
+        }
+        if (batch.dones) {
+            batch.dones[i] = done;
+        }
+
+        if (done != 0) {
+            game.reset(nextSeed(i));
+        }
+        writeObservation(i);
+    }
+}
+
+void BreakoutEnv::workerLoop(int thread) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batchStarted.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runRange(thread);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            batchFinished.notify_one();
+        }
+    }
+}
+
+void BreakoutEnv::runBatch(const Batch& next) {
+    batch = next;
+    if (!workers.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        batchStarted.notify_all();
+    }
+
+    runRange(0);
+
+    if (!workers.empty()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchFinished.wait(lock, [&] { return busyWorkers == 0; });
+    }
+}
+
+extern "C" {
+
+BreakoutEnvConfig breakout_env_default_config(void) {
+    BreakoutEnvConfig config;
+    config.mode = static_cast<int>(GameMode::CLASSIC);
+    config.frames_per_step = 4;
+    config.steps_per_second = 60;
+    config.max_frames = 5 * 60 * 60;
+    config.life_penalty = 1.0f;
+    config.seed = 1;
+    config.threads = 0;
+    return config;
+}
+
+BreakoutEnv* breakout_env_create(int count, const BreakoutEnvConfig* config) {
+    if (count <= 0 || !config || config->frames_per_step < 1 || config->steps_per_second < 1 ||
+        config->mode < 0 || config->mode > static_cast<int>(GameMode::CHAOS)) {
+        return nullptr;
+    }
+
+    BreakoutEnv* env = new BreakoutEnv();
+    env->config = *config;
+    env->batch = BreakoutEnv::Batch{};
+    env->generation = 0;
+    env->busyWorkers = 0;
+    env->stopping = false;
+
+    env->games.reserve(count);
+    env->seedStates.resize(count);
+    for (int i = 0; i < count; i++) {
+        // Distinct, non-zero stream per game
+        uint32_t state = (config->seed ^ 0x9E3779B9u) + static_cast<uint32_t>(i) * 2654435761u;
+        env->seedStates[i] = state != 0 ? state : 1;
+        env->games.emplace_back(static_cast<GameMode>(config->mode), config->steps_per_second, env->nextSeed(i));
+    }
+
+    const FixedSimulation& first = env->games.front();
+    env->brickWords = static_cast<int>(first.getBrickAlive().size());
+    env->inverseWidth = 1.0f / first.getPlayfieldSize().x.toFloat();
+    env->inverseHeight = 1.0f / first.getPlayfieldSize().y.toFloat();
+
+    int threads = config->threads > 0 ? config->threads : static_cast<int>(std::thread::hardware_concurrency());
+    env->threadCount = std::max(1, std::min(threads, count));
+    for (int thread = 1; thread < env->threadCount; thread++) {
+        env->workers.emplace_back(&BreakoutEnv::workerLoop, env, thread);
+    }
+    return env;
+}
+
+void breakout_env_destroy(BreakoutEnv* env) {
+    if (!env) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(env->mutex);
+        env->stopping = true;
+    }
+    env->batchStarted.notify_all();
+    for (std::thread& worker : env->workers) {
+        worker.join();
+    }
+    delete env;
+}
+
+int breakout_env_count(const BreakoutEnv* env) {
+    return static_cast<int>(env->games.size());
+}
+
+int breakout_env_brick_words(const BreakoutEnv* env) {
+    return env->brickWords;
+}
+
+int breakout_env_thread_count(const BreakoutEnv* env) {
+    return env->threadCount;
+}
+
+void breakout_env_reset(BreakoutEnv* env, float* observations, uint64_t* bricks) {
+    env->runBatch(BreakoutEnv::Batch{BreakoutEnv::Operation::RESET, nullptr, observations, bricks, nullptr, nullptr,
+                                     nullptr});
+}
+
+void breakout_env_step(BreakoutEnv* env, const int8_t* actions, float* observations, uint64_t* bricks,
+                       float* rewards, uint8_t* dones) {
+    env->runBatch(BreakoutEnv::Batch{BreakoutEnv::Operation::STEP, actions, observations, bricks, rewards, dones,
+                                     nullptr});
+}
+
+int breakout_env_set_pixels(BreakoutEnv* env, int width, int height, int channels) {
+    if (width <= 0 || height <= 0 || (channels != 1 && channels != 3)) {
+        return -1;
+    }
+    const FixedVector playfield = env->games.front().getPlayfieldSize();
+    const SoftwareRasterizer rasterizer(width, height, static_cast<SoftwareRasterizer::Format>(channels),
+                                        playfield.x.toFloat(), playfield.y.toFloat());
+    env->rasterizers.assign(env->games.size(), rasterizer);
+    return 0;
+}
+
+void breakout_env_render(BreakoutEnv* env, uint8_t* pixels) {
+    if (env->rasterizers.empty()) {
+        return;
+    }
+    env->runBatch(BreakoutEnv::Batch{BreakoutEnv::Operation::RENDER, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                     pixels});
+}
+
+}
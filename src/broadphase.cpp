@@ -0,0 +1,128 @@
+#include "../include/broadphase.h"
+#include <algorithm>
+
+SweepAndPrune::SweepAndPrune() : bodyCount(0), lastSortSwaps(0) {}
+
+int SweepAndPrune::add(const Rectangle& bounds, unsigned int category, unsigned int mask, int userData) {
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<int>(bodies.size());
+        bodies.emplace_back();
+    }
+
+    bodies[handle] = Body{bounds, category, mask, userData, -1, true, true};
+    bodyCount++;
+
+    // New endpoints go at the end; the next insertion sort moves them into place
+    endpoints.push_back(Endpoint{bounds.x, handle, true});
+    endpoints.push_back(Endpoint{bounds.x + bounds.width, handle, false});
+    return handle;
+}
+
+void SweepAndPrune::remove(int handle) {
+    endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                   [handle](const Endpoint& e) { return e.body == handle; }),
+                    endpoints.end());
+    bodies[handle].inUse = false;
+    bodies[handle].enabled = false;
+    freeHandles.push_back(handle);
+    bodyCount--;
+}
+
+void SweepAndPrune::update(int handle, const Rectangle& bounds) {
+    bodies[handle].bounds = bounds;
+}
+
+void SweepAndPrune::setEnabled(int handle, bool enabled) {
+    bodies[handle].enabled = enabled;
+}
+
+void SweepAndPrune::clear() {
+    bodies.clear();
+    freeHandles.clear();
+    endpoints.clear();
+    active.clear();
+    pairs.clear();
+    bodyCount = 0;
+}
+
+void SweepAndPrune::reserve(int count) {
+    bodies.reserve(count);
+    freeHandles.reserve(count);
+    endpoints.reserve(2 * count);
+    active.reserve(count);
+}
+
+bool SweepAndPrune::comesBefore(const Endpoint& lhs, const Endpoint& rhs) {
+    // Min endpoints sort before max endpoints at the same coordinate so that
+    // touching boxes count as overlapping, like CheckCollisionCircleRec
+    return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.isMin && !rhs.isMin);
+}
+
+void SweepAndPrune::sortEndpoints() {
+    // Refresh the cached coordinates from the current bounds
+    for (Endpoint& e : endpoints) {
+        const Rectangle& bounds = bodies[e.body].bounds;
+        e.value = e.isMin ? bounds.x : bounds.x + bounds.width;
+    }
+
+    // Insertion sort: O(n + swaps), and swaps stay small when bodies move a
+    // little each frame
+    int swaps = 0;
+    for (size_t i = 1; i < endpoints.size(); i++) {
+        Endpoint key = endpoints[i];
+        size_t j = i;
+        while (j > 0 && comesBefore(key, endpoints[j - 1])) {
+            endpoints[j] = endpoints[j - 1];
+            j--;
+            swaps++;
+        }
+        endpoints[j] = key;
+    }
+    lastSortSwaps = swaps;
+}
+
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::findPairs() {
+    sortEndpoints();
+    pairs.clear();
+    active.clear();
+
+    for (const Endpoint& e : endpoints) {
+        Body& body = bodies[e.body];
+        if (!body.enabled) {
+            continue;
+        }
+
+        if (!e.isMin) {
+            // Swap-remove from the active list
+            int slot = body.activeSlot;
+            int last = active.back();
+            active[slot] = last;
+            bodies[last].activeSlot = slot;
+            active.pop_back();
+            body.activeSlot = -1;
+            continue;
+        }
+
+        // Everything still active overlaps on x; check y and interest masks
+        for (int other : active) {
+            const Body& candidate = bodies[other];
+            bool interested = (body.mask & candidate.category) || (candidate.mask & body.category);
+            if (!interested) {
+                continue;
+            }
+            if (body.bounds.y <= candidate.bounds.y + candidate.bounds.height &&
+                candidate.bounds.y <= body.bounds.y + body.bounds.height) {
+                pairs.push_back(Pair{std::min(e.body, other), std::max(e.body, other)});
+            }
+        }
+
+        body.activeSlot = static_cast<int>(active.size());
+        active.push_back(e.body);
+    }
+
+    return pairs;
+}
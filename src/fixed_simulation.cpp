@@ -0,0 +1,645 @@
+#include "../include/fixed_simulation.h"
+#include "../include/brick_field.h"
+#include "../include/rotation_tables.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 2.30 -> 16.16, rounded to nearest
+    constexpr FixedVector toFixed(RotationTables::Rotation rotation) {
+        constexpr int64_t SHIFT = 30 - Fixed::FRACTION_BITS;
+        constexpr int64_t HALF = 1ll << (SHIFT - 1);
+        return FixedVector{ Fixed::fromRaw(static_cast<int32_t>((rotation.x + HALF) >> SHIFT)),
+                            Fixed::fromRaw(static_cast<int32_t>((rotation.y + HALF) >> SHIFT)) };
+    }
+
+    template <size_t N>
+    constexpr std::array<FixedVector, N> toFixedTable(const std::array<RotationTables::Rotation, N>& table) {
+        std::array<FixedVector, N> result{};
+        for (size_t i = 0; i < N; i++) {
+            result[i] = toFixed(table[i]);
+        }
+        return result;
+    }
+
+    constexpr std::array<FixedVector, RotationTables::DEFLECTION_STEPS> DEFLECTION =
+        toFixedTable(RotationTables::DEFLECTION);
+    constexpr std::array<FixedVector, RotationTables::PERTURBATION_STEPS> PERTURBATION =
+        toFixedTable(RotationTables::PERTURBATION);
+
+    constexpr Fixed PADDLE_HIT_RANGE = Fixed::fromFloat(RotationTables::PADDLE_HIT_RANGE);
+    constexpr Fixed SPIN_INFLUENCE = Fixed::fromFloat(BallTuning::SPIN_INFLUENCE);
+    constexpr Fixed MAX_SPIN = Fixed::fromFloat(BallTuning::MAX_SPIN);
+    constexpr Fixed CORNER_ZONE = Fixed::fromFloat(0.4f);  // of the brick size, from the centre
+    constexpr Fixed CORNER_SPIN = Fixed::fromFloat(0.2f);
+    constexpr Fixed FACE_SPIN = Fixed::fromFloat(0.1f);
+
+    // Launch direction, 45 degrees up and to the right
+    constexpr Fixed DIAGONAL = Fixed::fromFloat(0.70710678f);
+
+    // How far ahead predictPaddleLineFrame looks (about 4.5 hours at 60 Hz)
+    constexpr uint32_t MAX_LOOKAHEAD = 1u << 20;
+
+    // First frame in [lo, hi] where a predicate that flips from false to true
+    // at most once holds; hi + 1 if it never does
+    template <typename Predicate>
+    uint32_t firstFrameWhere(uint32_t lo, uint32_t hi, Predicate reached) {
+        uint32_t end = hi + 1;
+        while (lo < end) {
+            uint32_t mid = lo + (end - lo) / 2;
+            if (reached(mid)) {
+                end = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    // The same, starting from a guess: gallops away from it until the
+    // predicate changes, then bisects the last gap, so a guess within a frame
+    // or two costs a handful of evaluations
+    template <typename Predicate>
+    uint32_t firstFrameNear(uint32_t lo, uint32_t hi, uint32_t guess, Predicate reached) {
+        if (lo > hi) {
+            return lo;
+        }
+        uint32_t stride = 1;
+        if (reached(guess)) {
+            uint32_t known = guess;
+            while (known > lo) {
+                const uint32_t probe = known - std::min(stride, known - lo);
+                if (!reached(probe)) {
+                    return firstFrameWhere(probe + 1, known - 1, reached);
+                }
+                known = probe;
+                stride *= 2;
+            }
+            return lo;
+        }
+        uint32_t missed = guess;
+        while (missed < hi) {
+            const uint32_t probe = missed + std::min(stride, hi - missed);
+            if (reached(probe)) {
+                return firstFrameWhere(missed + 1, probe - 1, reached);
+            }
+            missed = probe;
+            stride *= 2;
+        }
+        return hi + 1;
+    }
+
+    void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void hashValue(uint64_t& hash, const T& value) {
+        hashBytes(hash, &value, sizeof(value));
+    }
+}
+
+FixedSimulation::FixedSimulation(GameMode mode, int stepsPerSecond, uint32_t seed)
+    : FixedSimulation(LevelDesign{mode, 0, 0, {}}, stepsPerSecond, seed) {}
+
+FixedSimulation::FixedSimulation(const LevelDesign& level, int stepsPerSecond, uint32_t seed)
+    : mode(level.mode), level(level), stepsPerSecond(stepsPerSecond), width(Fixed::fromInt(800)),
+      height(Fixed::fromInt(600)), paddleStep{}, ballBaseSpeed{}, speedIncrement{}, maxSpeed{}, spinDecay{},
+      speedUpFrames(0), rows(0), cols(0), brickCount(0), brickWidth{}, brickHeight{}, lastBrickHit(-1),
+      paddleX{}, paddleY{}, paddleWidth{}, paddleHeight{},
+      ballX{}, ballY{}, ballRadius{}, dirX{}, dirY{}, speed{}, spin{},
+      frame(0), lastSpeedUpFrame(0), rngState(1), score(0), lives(INITIAL_LIVES), bricksLeft(0) {
+    reset(seed);
+}
+
+template <typename Config>
+void FixedSimulation::setup() {
+    using Layout = BrickLayout<Config>;
+
+    paddleStep = Fixed::fromFloat(Config::PADDLE_BASE_SPEED) / stepsPerSecond;
+    ballBaseSpeed = Fixed::fromFloat(Config::BALL_BASE_SPEED);
+    speedIncrement = Fixed::fromFloat(Config::BALL_SPEED_INCREMENT);
+    maxSpeed = Fixed::fromFloat(Config::MAX_BALL_SPEED);
+    spinDecay = Fixed::fromFloat(BallTuning::SPIN_DECAY) / stepsPerSecond;
+    speedUpFrames = static_cast<uint32_t>(std::lround(Config::SPEED_INCREASE_INTERVAL * stepsPerSecond));
+
+    // Same placement as BrickField::layout, from the same compile-time table
+    rows = Layout::ROWS;
+    cols = Layout::COLS;
+    brickWidth = width * Fixed::fromFloat(Layout::WIDTH);
+    brickHeight = height * Fixed::fromFloat(Config::BRICK_HEIGHT);
+    brickCorners.resize(Layout::COUNT);
+    for (int i = 0; i < Layout::COUNT; i++) {
+        const BrickCell& cell = Layout::CELLS[i];
+        brickCorners[i] = FixedVector{ width * Fixed::fromFloat(cell.x),
+                                       width * Fixed::fromFloat(cell.yWidth) + height * Fixed::fromFloat(cell.yHeight) };
+    }
+    brickCount = Layout::COUNT;
+    brickHits.assign(Layout::COUNT, 1);
+    if (!level.hitPoints.empty()) {
+        for (int i = 0; i < Layout::COUNT; i++) {
+            brickHits[i] = i < static_cast<int>(level.hitPoints.size()) ? level.hitPoints[i] : 0;
+        }
+    }
+    brickAlive.assign((Layout::COUNT + 63) / 64, 0ull);
+    bricksLeft = 0;
+    for (int i = 0; i < Layout::COUNT; i++) {
+        if (brickHits[i] > 0) {
+            brickAlive[i / 64] |= 1ull << (i % 64);
+            bricksLeft++;
+        }
+    }
+}
+
+void FixedSimulation::reset(uint32_t seed) {
+    frame = 0;
+    score = 0;
+    lives = INITIAL_LIVES;
+    lastBrickHit = -1;
+    rngState = seed != 0 ? seed : 1;  // xorshift can't leave zero
+
+    switch (mode) {
+        case GameMode::CLASSIC:   setup<ClassicConfig>(); break;
+        case GameMode::MEGA_GRID: setup<MegaGridConfig>(); break;
+        case GameMode::CHAOS:     setup<ChaosConfig>(); break;
+        case GameMode::ENDLESS:   setup<EndlessConfig>(); break;
+    }
+    serve();
+}
+
+// Same placement as spawnPaddle/spawnBall on the 800x600 base playfield
+void FixedSimulation::serve() {
+    paddleWidth = Fixed::fromFloat(PaddleTuning::BASE_WIDTH);
+    paddleHeight = Fixed::fromFloat(PaddleTuning::BASE_HEIGHT);
+    paddleX = (width - paddleWidth).half();
+    paddleY = height * Fixed::fromFloat(PaddleTuning::Y_FRACTION);
+
+    ballRadius = Fixed::fromFloat(BallTuning::BASE_RADIUS);
+    ballX = width.half();
+    ballY = paddleY - ballRadius;
+    dirX = DIAGONAL;
+    dirY = -DIAGONAL;
+    speed = ballBaseSpeed / DIAGONAL;
+    spin = Fixed{};
+    lastSpeedUpFrame = frame;
+    serving = true;
+}
+
+void FixedSimulation::aimServe(int paddleAxis) {
+    if (!serving || isOver()) {
+        return;
+    }
+    paddleX = fixedClamp(paddleX + paddleStep * paddleAxis, Fixed{}, width - paddleWidth);
+    ballX = paddleX + paddleWidth.half();
+}
+
+uint32_t FixedSimulation::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+void FixedSimulation::addSpin(Fixed amount) {
+    spin = fixedClamp(spin + amount, -MAX_SPIN, MAX_SPIN);
+}
+
+Fixed FixedSimulation::decaySpin(Fixed value) const {
+    if (value > Fixed{}) {
+        return fixedMax(Fixed{}, value - spinDecay);
+    }
+    if (value < Fixed{}) {
+        return fixedMin(Fixed{}, value + spinDecay);
+    }
+    return value;
+}
+
+bool FixedSimulation::bounceOffWalls() {
+    bool bounced = false;
+    if (ballX - ballRadius < Fixed{}) {
+        ballX = ballRadius;
+        dirX = -dirX;
+        bounced = true;
+    }
+    if (ballX + ballRadius > width) {
+        ballX = width - ballRadius;
+        dirX = -dirX;
+        bounced = true;
+    }
+    if (ballY - ballRadius < Fixed{}) {
+        ballY = ballRadius;
+        dirY = -dirY;
+        bounced = true;
+    }
+    return bounced;
+}
+
+// Circle/rectangle overlap, edges inclusive; squared distances in 32.32
+bool FixedSimulation::ballOverlaps(Fixed x, Fixed y, Fixed rectWidth, Fixed rectHeight) const {
+    Fixed closestX = fixedClamp(ballX, x, x + rectWidth);
+    Fixed closestY = fixedClamp(ballY, y, y + rectHeight);
+    return fixedLengthSquared(ballX - closestX, ballY - closestY) <=
+           static_cast<int64_t>(ballRadius.raw) * ballRadius.raw;
+}
+
+bool FixedSimulation::resolvePaddle(int paddleAxis) {
+    if (!ballOverlaps(paddleX, paddleY, paddleWidth, paddleHeight)) {
+        return false;
+    }
+
+    // Hit position relative to the paddle centre (-1 to 1), then the table
+    // entry for it, rounded to nearest
+    const Fixed halfWidth = paddleWidth.half();
+    const Fixed hitOffset = (ballX - (paddleX + halfWidth)) / halfWidth;
+    const int64_t range = (PADDLE_HIT_RANGE * 2).raw;
+    const int64_t scaled = static_cast<int64_t>((fixedClamp(hitOffset, -PADDLE_HIT_RANGE, PADDLE_HIT_RANGE) +
+                                                 PADDLE_HIT_RANGE).raw) * (RotationTables::DEFLECTION_STEPS - 1);
+    const FixedVector& direction = DEFLECTION[static_cast<size_t>((scaled + range / 2) / range)];
+
+    ballY = paddleY - ballRadius;
+    dirX = direction.x;
+    dirY = direction.y;
+    addSpin((hitOffset + Fixed::fromInt(paddleAxis).half()).half());
+    return true;
+}
+
+bool FixedSimulation::resolveBricks() {
+    // Only the cells around the ball can be touched; the layout is a regular
+    // grid, so a one-cell margin covers rounding in the cell lookup. Rows
+    // then columns keeps the row-major priority of the float path.
+    const FixedVector origin = brickCorners[0];
+    const Fixed columnPitch = brickCorners[1].x - origin.x;
+    const Fixed rowPitch = brickCorners[cols].y - origin.y;
+    const int firstCol = std::max(0, (ballX - ballRadius - origin.x).raw / columnPitch.raw - 1);
+    const int lastCol = std::min(cols - 1, (ballX + ballRadius - origin.x).raw / columnPitch.raw + 1);
+    const int firstRow = std::max(0, (ballY - ballRadius - origin.y).raw / rowPitch.raw - 1);
+    const int lastRow = std::min(rows - 1, (ballY + ballRadius - origin.y).raw / rowPitch.raw + 1);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            const int index = row * cols + col;
+            const FixedVector& corner = brickCorners[index];
+            if (!isBrickAlive(index) || !ballOverlaps(corner.x, corner.y, brickWidth, brickHeight)) {
+                continue;
+            }
+
+            const Fixed dx = ballX - (corner.x + brickWidth.half());
+            const Fixed dy = ballY - (corner.y + brickHeight.half());
+            const bool isCornerCollision = fixedAbs(dx) > brickWidth * CORNER_ZONE &&
+                                           fixedAbs(dy) > brickHeight * CORNER_ZONE;
+
+            if (isCornerCollision) {
+                // Leave along the contact normal, rotated by up to 5 degrees
+                const Fixed length = Fixed::fromRaw(static_cast<int32_t>(integerSqrt(
+                    static_cast<uint64_t>(fixedLengthSquared(dx, dy)))));
+                const FixedVector normal = { dx / length, dy / length };
+                const FixedVector& rotation = PERTURBATION[nextRandom() % RotationTables::PERTURBATION_STEPS];
+                dirX = normal.x * rotation.x - normal.y * rotation.y;
+                dirY = normal.x * rotation.y + normal.y * rotation.x;
+                addSpin(dx > Fixed{} ? CORNER_SPIN : -CORNER_SPIN);
+            } else if (static_cast<int64_t>(fixedAbs(dx).raw) * brickHeight.raw >
+                       static_cast<int64_t>(fixedAbs(dy).raw) * brickWidth.raw) {
+                dirX = -dirX;
+                addSpin(dy > Fixed{} ? FACE_SPIN : -FACE_SPIN);
+            } else {
+                dirY = -dirY;
+                addSpin(dx > Fixed{} ? -FACE_SPIN : FACE_SPIN);
+            }
+
+            // Worth their starting hit points in score, like Health::scoreValue
+            lastBrickHit = index;
+            if (--brickHits[index] == 0) {
+                brickAlive[index / 64] &= ~(1ull << (index % 64));
+                bricksLeft--;
+                const int startingHits = level.hitPoints.empty() ? 1 : level.hitPoints[index];
+                score += BrickField<ClassicConfig>::SCORE_VALUE * startingHits;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Same order as Simulation::resolveFrame
+uint32_t FixedSimulation::step(int paddleAxis) {
+    if (isOver()) {
+        return 0;
+    }
+    frame++;
+    serving = false;
+
+    paddleX = fixedClamp(paddleX + paddleStep * paddleAxis, Fixed{}, width - paddleWidth);
+
+    const Fixed distance = speed / stepsPerSecond;
+    const Fixed stepX = dirX * distance;
+    ballX += stepX + stepX * (spin * SPIN_INFLUENCE);
+    ballY += dirY * distance;
+    spin = decaySpin(spin);
+
+    uint32_t events = 0;
+    if (bounceOffWalls()) {
+        events |= SIM_EVENT_WALL;
+    }
+
+    if (frame - lastSpeedUpFrame >= speedUpFrames) {
+        speed = fixedMin(speed + speedIncrement * (fixedAbs(dirX) + fixedAbs(dirY)), maxSpeed);
+        lastSpeedUpFrame = frame;
+        events |= SIM_EVENT_SPEED_UP;
+    }
+
+    if (resolvePaddle(paddleAxis)) {
+        events |= SIM_EVENT_PADDLE;
+    }
+    if (resolveBricks()) {
+        events |= SIM_EVENT_BRICK;
+    }
+
+    if (ballY + ballRadius > height) {
+        lives--;
+        if (lives > 0) {
+            serve();
+        }
+        return events | SIM_EVENT_LIFE_LOST;
+    }
+
+    if (bounceOffWalls()) {
+        events |= SIM_EVENT_WALL;
+    }
+    return events;
+}
+
+uint32_t FixedSimulation::step(FixedPaddleController& controller) {
+    if (isOver()) {
+        return 0;
+    }
+    const uint32_t events = step(controller.axis(frame + 1, paddleX));
+    if (events != 0) {
+        controller.onEvent(*this);
+    }
+    return events;
+}
+
+// The ball's path with the operations step() applies. Spin only bends the
+// x step until it has decayed to zero (MAX_SPIN / spinDecay frames at most);
+// from then on both steps are constant, so any later frame is one
+// multiplication per axis away.
+FixedSimulation::BallPath FixedSimulation::ballPath() const {
+    const Fixed distance = speed / stepsPerSecond;
+    BallPath path{dirX * distance, dirY * distance, 0, 0};
+    for (Fixed turning = spin; turning != Fixed{}; turning = decaySpin(turning)) {
+        path.spinX += (path.stepX + path.stepX * (turning * SPIN_INFLUENCE)).raw;
+        path.spinFrames++;
+    }
+    return path;
+}
+
+FixedSimulation::BallPoint FixedSimulation::ballAfter(const BallPath& path, uint32_t frames) const {
+    BallPoint point{ballX.raw, ballY.raw + static_cast<int64_t>(path.stepY.raw) * frames, Fixed{}};
+    if (frames >= path.spinFrames) {
+        point.x += path.spinX + static_cast<int64_t>(path.stepX.raw) * (frames - path.spinFrames);
+        return point;
+    }
+    point.spin = spin;
+    for (uint32_t i = 0; i < frames; i++) {
+        point.x += (path.stepX + path.stepX * (point.spin * SPIN_INFLUENCE)).raw;
+        point.spin = decaySpin(point.spin);
+    }
+    return point;
+}
+
+// Earliest frame in (frame, limit] on which step() could do anything but
+// move. Along one segment x and y each move one way (spin scales the x step
+// by 0.7 to 1.3, never flips it), so "has the ball reached this line yet"
+// flips once. Past the spin frames the steps are constant, so the frame a
+// line is crossed can be worked out by division; the exact test then only
+// has to confirm it. Bounding boxes stand in for the circle tests, which can
+// only make the answer early: that frame is then stepped with nothing
+// happening.
+uint32_t FixedSimulation::nextEventFrame(uint32_t limit) const {
+    const uint32_t first = frame + 1;
+    if (first >= limit) {
+        return limit;
+    }
+
+    const int64_t radius = ballRadius.raw;
+    const int64_t paddleTop = paddleY.raw;
+    const BallPath path = ballPath();
+    auto at = [&](uint32_t f) { return ballAfter(path, f - frame); };
+    const BallPoint start = at(first);
+    if (start.x - radius < 0 || start.x + radius > width.raw || start.y - radius < 0 ||
+        start.y + radius >= paddleTop) {
+        return first;
+    }
+
+    // First frame in [lo, hi] where the x or y test holds, starting from
+    // where the coordinate reaches target once the spin has decayed
+    const int64_t xBase = ballX.raw + path.spinX;
+    const int64_t yBase = ballY.raw + static_cast<int64_t>(path.stepY.raw) * path.spinFrames;
+    auto crossing = [&](bool horizontal, uint32_t lo, uint32_t hi, int64_t target, auto reached) {
+        const int64_t base = horizontal ? xBase : yBase;
+        const int64_t step = horizontal ? path.stepX.raw : path.stepY.raw;
+        uint32_t guess = hi;
+        if (step != 0 && lo <= hi) {
+            const int64_t frames = static_cast<int64_t>(path.spinFrames) + (target - base) / step;
+            guess = static_cast<uint32_t>(std::clamp<int64_t>(frame + frames, lo, hi));
+        }
+        return firstFrameNear(lo, hi, guess, [&](uint32_t f) {
+            const BallPoint point = at(f);
+            return reached(horizontal ? point.x : point.y);
+        });
+    };
+
+    uint32_t best = std::min(limit, lastSpeedUpFrame + speedUpFrames);
+
+    // Walls ahead of the ball, and the paddle's top edge if falling
+    if (dirX < Fixed{}) {
+        best = std::min(best, crossing(true, first, best, radius, [&](int64_t x) { return x - radius < 0; }));
+    } else if (dirX > Fixed{}) {
+        best = std::min(best, crossing(true, first, best, width.raw - radius, [&](int64_t x) {
+            return x + radius > width.raw;
+        }));
+    }
+    if (dirY < Fixed{}) {
+        best = std::min(best, crossing(false, first, best, radius, [&](int64_t y) { return y - radius < 0; }));
+    } else if (dirY > Fixed{}) {
+        best = std::min(best, crossing(false, first, best, paddleTop - radius, [&](int64_t y) {
+            return y + radius >= paddleTop;
+        }));
+    }
+    if (best <= first) {
+        return first;
+    }
+
+    // Bricks inside the box the ball sweeps before `best`. For each, the
+    // frames where the ball's box overlaps it on one axis form an interval;
+    // the first possible contact is where the two intervals start to overlap.
+    // Bricks are visited nearest first, and the box shrinks with `best`.
+    int64_t sweptLeft, sweptRight, sweptTop, sweptBottom;
+    auto sweep = [&]() {
+        const BallPoint end = at(best);
+        sweptLeft = std::min(start.x, end.x) - radius;
+        sweptRight = std::max(start.x, end.x) + radius;
+        sweptTop = std::min(start.y, end.y) - radius;
+        sweptBottom = std::max(start.y, end.y) + radius;
+    };
+    sweep();
+
+    auto axisInterval = [&](bool horizontal, Fixed direction, int64_t low, int64_t high,
+                            uint32_t& enter, uint32_t& exit) {
+        if (direction > Fixed{}) {
+            enter = crossing(horizontal, first, best, low - radius, [&](int64_t v) { return v + radius >= low; });
+            exit = crossing(horizontal, enter, best, high + radius, [&](int64_t v) { return v - radius > high; });
+        } else if (direction < Fixed{}) {
+            enter = crossing(horizontal, first, best, high + radius, [&](int64_t v) { return v - radius <= high; });
+            exit = crossing(horizontal, enter, best, low - radius, [&](int64_t v) { return v + radius < low; });
+        } else {
+            const int64_t value = horizontal ? start.x : start.y;
+            enter = value + radius >= low && value - radius <= high ? first : best + 1;
+            exit = best + 1;
+        }
+    };
+
+    // The grid cells under the swept box, with resolveBricks' one-cell margin
+    const FixedVector origin = brickCorners[0];
+    const int64_t columnPitch = brickCorners[1].x.raw - origin.x.raw;
+    const int64_t rowPitch = brickCorners[cols].y.raw - origin.y.raw;
+    const int64_t firstCol = std::max<int64_t>(0, (sweptLeft - origin.x.raw) / columnPitch - 1);
+    const int64_t lastCol = std::min<int64_t>(cols - 1, (sweptRight - origin.x.raw) / columnPitch + 1);
+    const int64_t firstRow = std::max<int64_t>(0, (sweptTop - origin.y.raw) / rowPitch - 1);
+    const int64_t lastRow = std::min<int64_t>(rows - 1, (sweptBottom - origin.y.raw) / rowPitch + 1);
+
+    const bool rowsUp = dirY < Fixed{};
+    const bool colsLeft = dirX < Fixed{};
+    for (int64_t r = firstRow; r <= lastRow; r++) {
+        const int64_t row = rowsUp ? firstRow + lastRow - r : r;
+        for (int64_t c = firstCol; c <= lastCol; c++) {
+            const int64_t col = colsLeft ? firstCol + lastCol - c : c;
+            const int index = static_cast<int>(row * cols + col);
+            const FixedVector& corner = brickCorners[index];
+            const int64_t left = corner.x.raw;
+            const int64_t right = left + brickWidth.raw;
+            const int64_t top = corner.y.raw;
+            const int64_t bottom = top + brickHeight.raw;
+            if (!isBrickAlive(index) || left > sweptRight || right < sweptLeft || top > sweptBottom ||
+                bottom < sweptTop) {
+                continue;
+            }
+            uint32_t enterX, exitX, enterY, exitY;
+            axisInterval(true, dirX, left, right, enterX, exitX);
+            if (enterX >= best) {
+                continue;
+            }
+            axisInterval(false, dirY, top, bottom, enterY, exitY);
+            const uint32_t enter = std::max(enterX, enterY);
+            if (enter < std::min(exitX, exitY) && enter < best) {
+                best = enter;
+                if (best <= first) {
+                    return first;
+                }
+                sweep();
+            }
+        }
+    }
+    return std::max(best, first);
+}
+
+// Only the paddle takes input on frames without events; the ball lands
+// where ballAfter puts it
+void FixedSimulation::skipFrames(FixedPaddleController& controller, uint32_t frames) {
+    const BallPoint point = ballAfter(ballPath(), frames);
+    for (uint32_t i = 0; i < frames; i++) {
+        frame++;
+        paddleX = fixedClamp(paddleX + paddleStep * controller.axis(frame, paddleX), Fixed{}, width - paddleWidth);
+    }
+    ballX = Fixed::fromRaw(static_cast<int32_t>(point.x));
+    ballY = Fixed::fromRaw(static_cast<int32_t>(point.y));
+    spin = point.spin;
+}
+
+uint32_t FixedSimulation::fastForward(FixedPaddleController& controller, uint32_t maxFrames) {
+    const uint32_t limit = frame + maxFrames;
+    while (!isOver() && frame < limit) {
+        const uint32_t target = nextEventFrame(limit);
+        if (target > frame + 1) {
+            skipFrames(controller, target - frame - 1);
+        }
+        const uint32_t events = step(controller);
+        if (events != 0) {
+            return events;
+        }
+    }
+    return 0;
+}
+
+uint32_t FixedSimulation::predictPaddleLineFrame() const {
+    if (dirY <= Fixed{}) {
+        return UINT32_MAX;
+    }
+    const BallPath path = ballPath();
+    const uint32_t reached = firstFrameWhere(frame + 1, frame + MAX_LOOKAHEAD, [&](uint32_t f) {
+        return ballAfter(path, f - frame).y + ballRadius.raw >= paddleY.raw;
+    });
+    return reached > frame + MAX_LOOKAHEAD ? UINT32_MAX : reached;
+}
+
+Fixed FixedSimulation::predictPaddleLineX(uint32_t atFrame) const {
+    const int64_t period = 2 * static_cast<int64_t>(width.raw);
+    int64_t x = ballAfter(ballPath(), atFrame - frame).x % period;
+    if (x < 0) {
+        x += period;
+    }
+    if (x > width.raw) {
+        x = period - x;
+    }
+    return Fixed::fromRaw(static_cast<int32_t>(x));
+}
+
+uint64_t FixedSimulation::stateHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    hashValue(hash, frame);
+    hashValue(hash, score);
+    hashValue(hash, lives);
+    hashValue(hash, bricksLeft);
+    for (Fixed value : { ballX, ballY, dirX, dirY, speed, spin, paddleX }) {
+        hashValue(hash, value.raw);
+    }
+    // One byte per brick: the hit points left, which for the full grid is
+    // the alive flag the hash has always covered
+    for (int i = 0; i < brickCount; i++) {
+        hashValue(hash, brickHits[i]);
+    }
+    return hash;
+}
+
+FixedTrackingBot::FixedTrackingBot(uint32_t seed)
+    : rng(seed != 0 ? seed : 1), target(Fixed::fromInt(400)), paddleWidth(Fixed::fromFloat(PaddleTuning::BASE_WIDTH)) {}
+
+void FixedTrackingBot::onEvent(const FixedSimulation& simulation) {
+    paddleWidth = simulation.getPaddleWidth();
+    const uint32_t arrival = simulation.predictPaddleLineFrame();
+    if (arrival == UINT32_MAX) {
+        return;
+    }
+    // Up to 40% of the paddle width either side of its centre
+    const int64_t offset = static_cast<int64_t>(next() % 1000) - 500;
+    const Fixed aim = Fixed::fromRaw(static_cast<int32_t>((paddleWidth * Fixed::fromFloat(0.8f)).raw * offset / 1000));
+    target = simulation.predictPaddleLineX(arrival) - aim;
+}
+
+int FixedTrackingBot::axis(uint32_t, Fixed paddleX) {
+    const Fixed difference = target - (paddleX + paddleWidth.half());
+    if (difference > DEAD_ZONE) return 1;
+    if (difference < -DEAD_ZONE) return -1;
+    return 0;
+}
+
+uint32_t FixedTrackingBot::next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
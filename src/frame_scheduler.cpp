@@ -0,0 +1,120 @@
+#include "../include/frame_scheduler.h"
+#include <raylib.h>
+#include <algorithm>
+
+FrameScheduler::FrameScheduler(double framePeriod)
+    : framePeriod(framePeriod), frameStart(0.0), drawCost(0.0), workCost(0.0), lastBudget(0.0), lastRunCount(0),
+      lastDeferredCount(0) {}
+
+int FrameScheduler::addTask(const char* name, Priority priority, Phase phase, double slice, TaskFunction function) {
+    tasks.push_back(Task{name, priority, phase, slice, std::move(function), false, 0, TaskStats{0.0, 0.0, 0, 0, 0}});
+    return static_cast<int>(tasks.size()) - 1;
+}
+
+void FrameScheduler::request(int task) {
+    tasks[task].pending = true;
+}
+
+void FrameScheduler::beginFrame() {
+    frameStart = GetTime();
+    lastRunCount = 0;
+    lastDeferredCount = 0;
+}
+
+void FrameScheduler::addDrawCost(double seconds) {
+    drawCost += COST_SMOOTHING * (seconds - drawCost);
+}
+
+void FrameScheduler::addWorkCost(double seconds) {
+    workCost += COST_SMOOTHING * (seconds - workCost);
+}
+
+double FrameScheduler::run() {
+    const double deadline = frameStart + framePeriod - drawCost - SAFETY_MARGIN;
+    lastBudget = std::max(0.0, deadline - GetTime());
+    const Phase phase = Phase::BEFORE_DRAW;
+    return runPending(deadline, &phase, false);
+}
+
+// Called at the top of a frame, so this frame's update, recording and
+// drawing are all still ahead and stay reserved; what's spent here is gone
+// from run's budget
+double FrameScheduler::runAfterDraw() {
+    const Phase phase = Phase::AFTER_DRAW;
+    return runPending(frameStart + framePeriod - workCost - drawCost - SAFETY_MARGIN, &phase, false);
+}
+
+double FrameScheduler::runIdle(double budget) {
+    lastBudget = budget;
+    return runPending(GetTime() + budget, nullptr, true);
+}
+
+// A task that has never run has no cost estimate yet; it gets one try as
+// soon as any time is left
+bool FrameScheduler::fits(const Task& task, double remaining) const {
+    if (task.slice > 0.0) {
+        return remaining >= MIN_SLICE;
+    }
+    return remaining > 0.0 && (task.stats.runs == 0 || task.stats.averageSeconds <= remaining);
+}
+
+void FrameScheduler::execute(Task& task, double budget) {
+    task.pending = false;
+    task.framesWaiting = 0;
+
+    const double start = GetTime();
+    const bool more = task.function(budget);
+    const double elapsed = GetTime() - start;
+
+    TaskStats& stats = task.stats;
+    stats.averageSeconds = stats.runs == 0 ? elapsed
+                                           : stats.averageSeconds + COST_SMOOTHING * (elapsed - stats.averageSeconds);
+    stats.maxSeconds = std::max(stats.maxSeconds, elapsed);
+    stats.runs++;
+    task.pending = task.pending || more;  // the task may have re-requested itself
+}
+
+double FrameScheduler::runPending(double deadline, const Phase* phase, bool idle) {
+    const double start = GetTime();
+
+    // Starving tasks first, then by priority, then longest waiting
+    order.clear();
+    for (int i = 0; i < static_cast<int>(tasks.size()); i++) {
+        if (tasks[i].pending && (!phase || tasks[i].phase == *phase)) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        const Task& left = tasks[a];
+        const Task& right = tasks[b];
+        const bool leftForced = left.framesWaiting >= MAX_WAIT_FRAMES;
+        const bool rightForced = right.framesWaiting >= MAX_WAIT_FRAMES;
+        if (leftForced != rightForced) {
+            return leftForced;
+        }
+        if (left.priority != right.priority) {
+            return left.priority < right.priority;
+        }
+        return left.framesWaiting > right.framesWaiting;
+    });
+
+    for (int index : order) {
+        Task& task = tasks[index];
+        const double remaining = deadline - GetTime();
+        const bool forced = task.framesWaiting >= MAX_WAIT_FRAMES;
+        if (!forced && !fits(task, remaining)) {
+            task.framesWaiting++;
+            task.stats.deferrals++;
+            lastDeferredCount++;
+            continue;
+        }
+
+        if (forced) {
+            task.stats.forcedRuns++;
+        }
+        const double budget = std::max(remaining, MIN_SLICE);
+        execute(task, task.slice > 0.0 && !idle ? std::min(task.slice, budget) : budget);
+        lastRunCount++;
+    }
+    return std::max(0.0, std::min(GetTime(), deadline) - start);
+}
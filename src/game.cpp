@@ -1,12 +1,45 @@
 #include "../include/game.h"
+#include "../include/memory_tracker.h"
+#include <rlgl.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#include <GLES2/gl2.h>
+#else
+#include <GL/gl.h>
+#endif
+#include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <ctime>
 #include <algorithm>
 
 // Initialize static members
 float Game::SpeedConfig::VIRTUAL_WIDTH = 800.0f;
 float Game::SpeedConfig::VIRTUAL_HEIGHT = 600.0f;
 
+namespace {
+    // Render targets live on the GPU, out of the allocator's sight, so they
+    // are charged by hand: a color attachment and raylib's 24-bit depth
+    // renderbuffer, each taken as 4 bytes per pixel
+    size_t renderTargetBytes(const RenderTexture2D& target) {
+        return static_cast<size_t>(target.texture.width) * target.texture.height * 8;
+    }
+
+    RenderTexture2D loadRenderTarget(int width, int height) {
+        RenderTexture2D target = LoadRenderTexture(width, height);
+        if (target.id != 0) {
+            MemoryTracker::charge(MemoryTag::RENDER_TARGETS, renderTargetBytes(target));
+        }
+        return target;
+    }
+
+    void unloadRenderTarget(RenderTexture2D& target) {
+        MemoryTracker::release(MemoryTag::RENDER_TARGETS, renderTargetBytes(target));
+        UnloadRenderTexture(target);
+        target = RenderTexture2D{};
+    }
+}
+
 // Method to detect touch capability
 void Game::detectTouchDevice() {
     // In Raylib, we can check for touch capability by trying to get touch positions
@@ -29,295 +62,104 @@ void Game::detectTouchDevice() {
     // isTouchDevice = true;
 }
 
-Game::~Game() = default;
-
-// Paddle implementation
-Game::Paddle::Paddle(float x, float y, float width, float height, float speed)
-    : x(x), y(y), width(width), height(height), baseSpeed(speed),
-      baseWidth(width), baseHeight(height), touchActive(false), lastTouchX(0.0f),
-      touchEnabled(false) {}
-
-void Game::Paddle::update(float deltaTime) {
-    float scaledSpeed = baseSpeed * SpeedConfig::getWidthScale();
-    
-    // Handle keyboard input
-    if (IsKeyDown(KEY_LEFT)) {
-        x -= scaledSpeed * deltaTime;
-    }
-    if (IsKeyDown(KEY_RIGHT)) {
-        x += scaledSpeed * deltaTime;
-    }
-    
-    // Handle touch input if the game indicates that touch is available
-    // Note: Since we don't have direct access to the Game instance here, 
-    // we still call updateTouchInput but will check inside that method
-    updateTouchInput(deltaTime);
-    
-    clampToScreen();
-}
-
-void Game::Paddle::updateTouchInput(float deltaTime) {
-    // Skip touch processing if not enabled
-    if (!touchEnabled) {
-        return;
-    }
-    
-    float scaledSpeed = baseSpeed * SpeedConfig::getWidthScale() * 1.5f; // Slightly faster for touch
-    
-    // Using GESTURE_DRAG is better for paddle control than including GESTURE_TAP
-    if (IsGestureDetected(GESTURE_DRAG)) {
-        Vector2 touchPosition = GetTouchPosition(0); // Get the first touch point
-        
-        // Only control paddle if touch is in the lower half of the screen
-        // This prevents accidental paddle movement when trying to tap bricks
-        if (touchPosition.y > SpeedConfig::VIRTUAL_HEIGHT * 0.5f) {
-            // If this is the start of a new touch sequence
-            if (!touchActive) {
-                touchActive = true;
-                lastTouchX = touchPosition.x;
-            } else {
-                // Calculate movement based on touch difference
-                float touchDifference = touchPosition.x - lastTouchX;
-                if (fabs(touchDifference) > 1.0f) { // Small threshold to prevent tiny movements
-                    x += touchDifference;
-                    lastTouchX = touchPosition.x;
-                }
-            }
-        }
-    } else {
-        // No touch detected
-        touchActive = false;
+Game::~Game() {
+    // The render target lives on the GPU and must go before the GL context does
+    if (IsWindowReady()) {
+        if (sceneTarget.id != 0) unloadRenderTarget(sceneTarget);
+        if (brickLayer.id != 0) unloadRenderTarget(brickLayer);
+        if (rasterTarget.id != 0) unloadRenderTarget(rasterTarget);
     }
 }
 
-void Game::Paddle::updateDimensions() {
-    width = baseWidth * SpeedConfig::getWidthScale();
-    height = baseHeight * SpeedConfig::getHeightScale();
-    clampToScreen();
-}
-
-void Game::Paddle::clampToScreen() {
-    x = std::max(0.0f, std::min(x, SpeedConfig::VIRTUAL_WIDTH - width));
-}
-
-void Game::Paddle::draw() {
-    DrawRectangle(static_cast<int>(x), static_cast<int>(y), 
-                 static_cast<int>(width), static_cast<int>(height), 
-                 BLUE);
-}
-
-Rectangle Game::Paddle::getRect() const {
-    return Rectangle{x, y, width, height};
-}
-
-void Game::Paddle::setX(float newX) {
-    x = newX;
-    clampToScreen();
-}
-
-// Ball implementation
-Game::Ball::Ball(float x, float y, float radius, float speedX, float speedY)
-    : x(x), y(y), radius(radius), baseRadius(radius),
-      baseSpeedX(speedX), baseSpeedY(speedY), spin(0.0f) {}
-
-void Game::Ball::updateDimensions() {
-    // Use the average of width and height scale for the radius
-    float scale = (SpeedConfig::getWidthScale() + SpeedConfig::getHeightScale()) * 0.5f;
-    radius = baseRadius * scale;
-    clampToScreen();
-}
-
-void Game::Ball::update(float deltaTime) {
-    float widthScale = SpeedConfig::getWidthScale();
-    float heightScale = SpeedConfig::getHeightScale();
-    
-    // Apply spin influence to the velocity
-    float spinInfluence = spin * SPIN_INFLUENCE;
-    x += (baseSpeedX + baseSpeedX * spinInfluence) * widthScale * deltaTime;
-    y += baseSpeedY * heightScale * deltaTime;
-    
-    // Decay spin over time
-    applySpinDecay(deltaTime);
-    clampToScreen();
-}
-
-void Game::Ball::clampToScreen() {
-    // Bounce off screen edges
-    if (x - radius < 0) {
-        x = radius;
-        reverseX();
-    }
-    if (x + radius > SpeedConfig::VIRTUAL_WIDTH) {
-        x = SpeedConfig::VIRTUAL_WIDTH - radius;
-        reverseX();
-    }
-    if (y - radius < 0) {
-        y = radius;
-        reverseY();
-    }
-    // Don't clamp bottom edge - that's for life loss detection
-}
-
-void Game::Ball::draw() {
-    DrawCircle(static_cast<int>(x), static_cast<int>(y), radius, WHITE);
-}
-
-Vector2 Game::Ball::getPosition() const {
-    return Vector2{x, y};
-}
-
-float Game::Ball::getRadius() const {
-    return radius;
-}
-
-void Game::Ball::setPosition(float newX, float newY) {
-    x = newX;
-    y = newY;
-    clampToScreen();
-}
-
-void Game::Ball::reverseX() {
-    baseSpeedX = -baseSpeedX;
-}
-
-void Game::Ball::reverseY() {
-    baseSpeedY = -baseSpeedY;
-}
-
-void Game::Ball::increaseSpeed(float increment) {
-    if (baseSpeedX > 0) baseSpeedX += increment;
-    else baseSpeedX -= increment;
-    if (baseSpeedY > 0) baseSpeedY += increment;
-    else baseSpeedY -= increment;
-}
-
-void Game::Ball::setSpeed(float newSpeedX, float newSpeedY) {
-    baseSpeedX = newSpeedX;
-    baseSpeedY = newSpeedY;
-}
-
-void Game::Ball::clampSpeed(float maxSpeed) {
-    float currentSpeed = sqrt(baseSpeedX * baseSpeedX + baseSpeedY * baseSpeedY);
-    if (currentSpeed > maxSpeed) {
-        float scale = maxSpeed / currentSpeed;
-        baseSpeedX *= scale;
-        baseSpeedY *= scale;
-    }
-}
-
-void Game::Ball::setVelocity(float angleInRadians, float speed) {
-    baseSpeedX = speed * cos(angleInRadians);
-    baseSpeedY = speed * sin(angleInRadians);
-}
-
-void Game::Ball::addSpin(float spinValue) {
-    spin = std::clamp(spin + spinValue, -MAX_SPIN, MAX_SPIN);
-}
-
-void Game::Ball::applySpinDecay(float deltaTime) {
-    if (spin > 0.0f) {
-        spin = std::max(0.0f, spin - SPIN_DECAY * deltaTime);
-    } else if (spin < 0.0f) {
-        spin = std::min(0.0f, spin + SPIN_DECAY * deltaTime);
+// Game implementation
+void Game::initializeBricks() {
+    switch (mode) {
+        case GameMode::CLASSIC:   bricks.emplace<BrickField<ClassicConfig>>(); break;
+        case GameMode::MEGA_GRID: bricks.emplace<BrickField<MegaGridConfig>>(); break;
+        case GameMode::CHAOS:     bricks.emplace<BrickField<ChaosConfig>>(); break;
+        case GameMode::ENDLESS:   bricks.emplace<BrickField<EndlessConfig>>(); break;
     }
-}
-
-// Brick implementation remains the same...
-Game::Brick::Brick(float x, float y, float width, float height, bool isAlive)
-    : x(x), y(y), width(width), height(height), alive(isAlive) {}
 
-void Game::Brick::draw() {
-    if (alive) {
-        DrawRectangle(static_cast<int>(x), static_cast<int>(y), 
-                     static_cast<int>(width), static_cast<int>(height), 
-                     color);
-    }
-}
+    // Replace the previous level's bricks; paddle and ball are kept
+    MemoryScope scope(MemoryTag::BRICKS);
+    world.destroyAll<BrickArchetype>();
+    std::visit([this](auto& field) {
+        if (mode == GameMode::ENDLESS) {
+            field.spawn(world, SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT, currentLevel);
+        } else {
+            field.spawn(world, SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT);
+        }
+    }, bricks);
 
-Rectangle Game::Brick::getRect() const {
-    return Rectangle{x, y, width, height};
+    rebuildBroadphase();
+    brickLayerDirty = true;
+#ifdef BREAKOUT_FIXED_POINT
+    restartFixedSimulation();
+#endif
 }
 
-bool Game::Brick::isAlive() const {
-    return alive;
-}
+void Game::rebuildBroadphase() {
+    broadphase.clear();
 
-void Game::Brick::destroy() {
-    alive = false;
-}
+    world.each<Position, Collider, Health>([this](Entity entity, Position& position, Collider& collider, Health&) {
+        collider.broadphaseHandle = broadphase.add(boxBounds(position, collider), LAYER_BRICK, LAYER_BALL,
+                                                   static_cast<int>(entity.index));
+    });
 
-void Game::Brick::setColor(Color c) {
-    color = c;
+    // Ball and paddle bounds are refreshed every frame by updateBroadphase
+    paddleBody = broadphase.add(Rectangle{}, LAYER_PADDLE, LAYER_BALL, 0);
+    ballBody = broadphase.add(Rectangle{}, LAYER_BALL, LAYER_BRICK | LAYER_PADDLE, 0);
 }
 
-// Game implementation
-void Game::initializeBricks() {
-    const int rows = 8;
-    const int cols = 14;
-    
-    const float brickSpacing = SpeedConfig::VIRTUAL_WIDTH * 0.003f;
-    const float totalSpacing = brickSpacing * (cols + 1);
-    const float brickWidth = (SpeedConfig::VIRTUAL_WIDTH - totalSpacing) / cols;
-    const float brickHeight = SpeedConfig::VIRTUAL_HEIGHT * 0.033f;
+void Game::updateBroadphase() {
+    broadphase.update(ballBody, circleBounds(world.get<Position>(ballEntity), world.get<Collider>(ballEntity)));
+    broadphase.update(paddleBody, getPaddleRect());
 
-    bricks.clear();
-    bricks.resize(rows);
-    
-    for (int i = 0; i < rows; i++) {
-        bricks[i].reserve(cols);
-        for (int j = 0; j < cols; j++) {
-            float x = brickSpacing + j * (brickWidth + brickSpacing);
-            float y = brickSpacing + i * (brickHeight + brickSpacing) + (SpeedConfig::VIRTUAL_HEIGHT * 0.083f);
-            
-            auto brick = std::make_unique<Brick>(x, y, brickWidth, brickHeight, true);
-            
-            Color rowColors[8] = {
-                GREEN, GREEN,     // Bottom rows
-                YELLOW, YELLOW,   // Middle rows
-                ORANGE, ORANGE,   // Upper middle rows
-                RED, RED         // Top rows
-            };
-            brick->setColor(rowColors[i]);
-            
-            bricks[i].push_back(std::move(brick));
+    paddleCandidate = false;
+    brickCandidates.clear();
+    for (const SweepAndPrune::Pair& pair : broadphase.findPairs()) {
+        if (pair.a != ballBody && pair.b != ballBody) {
+            continue;
+        }
+        int other = pair.a == ballBody ? pair.b : pair.a;
+        if (broadphase.getCategory(other) == LAYER_PADDLE) {
+            paddleCandidate = true;
+        } else if (broadphase.getCategory(other) == LAYER_BRICK) {
+            brickCandidates.push_back(world.entityAt(static_cast<uint32_t>(broadphase.getUserData(other))));
         }
     }
 }
 
-Game::Game() : ballSpeedTimer(0.0f), isTouchDevice(false) {
+Game::Game(GameMode mode) : governor(1.0f / TARGET_FPS), sceneTarget{}, frameStart(0.0), deferredTime(0.0),
+               lastWorkTime(0.0f), brickLayer{}, brickLayerDirty(true),
+               needsRedraw(true), skippedLastFrame(false), idleFramesSkipped(0), brickLayerRepaints(0),
+               renderCommandsDirty(true), renderCommandReuses(0), rasterTarget{},
+               rasterizer(RASTER_CHECK_WIDTH, RASTER_CHECK_HEIGHT, SoftwareRasterizer::Format::RGB,
+                          SpeedConfig::BASE_WINDOW_WIDTH, SpeedConfig::BASE_WINDOW_HEIGHT),
+               ballBody(-1), paddleBody(-1), paddleCandidate(false), telemetry("telemetry.bktl"),
+               rallyHits(0), rallyStartMs(0), gameStartMs(0), saves("save.bksv"),
+               newHighScore(false), levels(LevelQueue::defaultWorkerCount()),
+               currentLevel{},
+#ifdef BREAKOUT_FIXED_POINT
+               fixedSimulation(mode, TARGET_FPS, 1), fixedAccumulator(0.0f), fixedScore(0),
+#endif
+               scheduler(1.0 / TARGET_FPS), telemetryTask(-1), saveLoadTask(-1),
+               saveWriteTask(-1), levelTask(-1), spectatorVisible(false), spectatorTick(0),
+               spectatorWindowStart(0.0), spectatorWindowBytes(0), spectatorWindowEncode(0.0),
+               spectatorWindowDecode(0.0), spectatorWindowTicks(0), spectatorSummary{}, reportedHeapPeak(0),
+               paddleInput{0.0f, 0.0f}, touchActive(false),
+               lastTouchX(0.0f), paddleEntity(NULL_ENTITY), ballEntity(NULL_ENTITY), mode(mode),
+               ballSpeedTimer(0.0f), isTouchDevice(false) {
     SpeedConfig::updateVirtualDimensions();
+    addDeferredTasks();
+    reserveStorage();
     
     // Detect touch capability
     detectTouchDevice();
     
-    // Initialize paddle with dimensions relative to base window size
-    const float paddleWidth = SpeedConfig::BASE_WINDOW_WIDTH * 0.125f;
-    const float paddleHeight = SpeedConfig::BASE_WINDOW_HEIGHT * 0.033f;
-    const float paddleY = SpeedConfig::VIRTUAL_HEIGHT * 0.9f;
-    
-    paddle = std::make_unique<Paddle>(
-        (SpeedConfig::VIRTUAL_WIDTH - paddleWidth * SpeedConfig::getWidthScale()) / 2,
-        paddleY,
-        paddleWidth,
-        paddleHeight,
-        SpeedConfig::PADDLE_BASE_SPEED
-    );
-    
-    // Set touch enabled flag on paddle
-    paddle->setTouchEnabled(isTouchDevice);
-
-    // Initialize ball with radius relative to base window size
-    const float ballRadius = SpeedConfig::BASE_WINDOW_WIDTH * 0.0125f;
-    
-    ball = std::make_unique<Ball>(
-        SpeedConfig::VIRTUAL_WIDTH / 2,
-        paddleY - ballRadius * SpeedConfig::getHeightScale(),
-        ballRadius,
-        SpeedConfig::BALL_BASE_SPEED,
-        -SpeedConfig::BALL_BASE_SPEED
-    );
-
+    // Bricks first: paddle and ball speeds come from the mode's config
     initializeBricks();
+    resetBallAndPaddle();
     
     state = GameState::START_SCREEN;
     gameOver = false;
@@ -329,6 +171,26 @@ Game::Game() : ballSpeedTimer(0.0f), isTouchDevice(false) {
     updateCamera();
 }
 
+// Everything a session can need is sized here, so mode switches, restarts
+// and new endless levels reuse it instead of allocating mid-game
+void Game::reserveStorage() {
+    constexpr int MAX_BRICKS = std::max({BrickField<ClassicConfig>::COUNT, BrickField<MegaGridConfig>::COUNT,
+                                         BrickField<ChaosConfig>::COUNT, BrickField<EndlessConfig>::COUNT});
+    {
+        MemoryScope scope(MemoryTag::BRICKS);
+        world.archetype<BrickArchetype>().reserve(MAX_BRICKS);
+        broadphase.reserve(MAX_BRICKS + 2);
+        brickCandidates.reserve(MAX_BRICKS);
+    }
+    brickCommands.reserve(MAX_BRICKS, 0);
+    frameCommands.reserve(FRAME_COMMANDS, FRAME_TEXT_BYTES);
+
+    MemoryScope scope(MemoryTag::SPECTATOR);
+    spectatorCommands.reserve(MAX_BRICKS + 2, 0);
+    spectatorMessage.reserve(SPECTATOR_MESSAGE_BYTES);
+    spectatorWire.reserve(SPECTATOR_MESSAGE_BYTES);
+}
+
 void Game::updateCamera() {
     // Update virtual dimensions
     SpeedConfig::updateVirtualDimensions();
@@ -336,47 +198,20 @@ void Game::updateCamera() {
     // Re-detect touch capability in case device state changed
     detectTouchDevice();
     
-    // Update paddle touch enabled state
-    if (paddle) {
-        paddle->setTouchEnabled(isTouchDevice);
-    }
-    
     // Update game objects with new dimensions
-    if (paddle) {
-        paddle->updateDimensions();
-    }
-    if (ball) {
-        ball->updateDimensions();
-    }
+    resizeSystem(world, SpeedConfig::getPlayfield());
+    validateGameObjects();
     
     // Update brick positions and sizes without reinitializing
-    const int rows = 8;
-    const int cols = 14;
-    
-    const float brickSpacing = SpeedConfig::VIRTUAL_WIDTH * 0.003f;
-    const float totalSpacing = brickSpacing * (cols + 1);
-    const float brickWidth = (SpeedConfig::VIRTUAL_WIDTH - totalSpacing) / cols;
-    const float brickHeight = SpeedConfig::VIRTUAL_HEIGHT * 0.033f;
-
-    for (int i = 0; i < rows && i < bricks.size(); i++) {
-        for (int j = 0; j < cols && j < bricks[i].size(); j++) {
-            if (bricks[i][j]) {
-                float x = brickSpacing + j * (brickWidth + brickSpacing);
-                float y = brickSpacing + i * (brickHeight + brickSpacing) + (SpeedConfig::VIRTUAL_HEIGHT * 0.083f);
-                
-                // Store the current brick's state before replacing it
-                bool isAlive = bricks[i][j]->isAlive();
-                Color color = bricks[i][j]->getColor();
-                
-                // Create new brick with preserved state
-                auto newBrick = std::make_unique<Brick>(x, y, brickWidth, brickHeight, isAlive);
-                newBrick->setColor(color);
-                
-                // Replace the old brick
-                bricks[i][j] = std::move(newBrick);
-            }
-        }
-    }
+    std::visit([this](auto& field) {
+        field.layout(world, SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT);
+    }, bricks);
+    rebuildBroadphase();
+
+    // Layout changed, so the cached brick layer and the current frame are stale
+    brickLayerDirty = true;
+    renderCommandsDirty = true;
+    needsRedraw = true;
     
     // No need for camera scaling since we're using screen coordinates directly
     camera.offset = Vector2{0, 0};
@@ -386,141 +221,117 @@ void Game::updateCamera() {
 }
 
 void Game::resetBallAndPaddle() {
-    // Use base window dimensions for consistent sizing
-    const float paddleWidth = SpeedConfig::BASE_WINDOW_WIDTH * 0.125f;
-    const float paddleHeight = SpeedConfig::BASE_WINDOW_HEIGHT * 0.033f;
-    const float paddleY = SpeedConfig::VIRTUAL_HEIGHT * 0.9f;
-    
-    paddle = std::make_unique<Paddle>(
-        (SpeedConfig::VIRTUAL_WIDTH - paddleWidth * SpeedConfig::getWidthScale()) / 2,
-        paddleY,
-        paddleWidth,
-        paddleHeight,
-        SpeedConfig::PADDLE_BASE_SPEED
-    );
-    
-    // Use base window dimensions for consistent ball sizing
-    const float ballRadius = SpeedConfig::BASE_WINDOW_WIDTH * 0.0125f;
-    ball = std::make_unique<Ball>(
-        SpeedConfig::VIRTUAL_WIDTH / 2,
-        paddleY - ballRadius * SpeedConfig::getHeightScale(),
-        ballRadius,
-        SpeedConfig::BALL_BASE_SPEED,
-        -SpeedConfig::BALL_BASE_SPEED
-    );
-    
+    const float paddleSpeed = std::visit([](auto& field) { return ConfigOf<decltype(field)>::PADDLE_BASE_SPEED; }, bricks);
+    const float ballSpeed = std::visit([](auto& field) { return ConfigOf<decltype(field)>::BALL_BASE_SPEED; }, bricks);
+    const Playfield playfield = SpeedConfig::getPlayfield();
+
+    MemoryScope scope(MemoryTag::BALLS);
+    world.destroy(paddleEntity);
+    world.destroy(ballEntity);
+    paddleEntity = spawnPaddle(world, playfield, paddleSpeed);
+    ballEntity = spawnBall(world, playfield, ballSpeed);
+
+    resizeSystem(world, playfield);
     ballSpeedTimer = 0.0f;
 }
 
+Rectangle Game::getPaddleRect() {
+    return boxBounds(world.get<Position>(paddleEntity), world.get<Collider>(paddleEntity));
+}
+
 void Game::validateGameObjects() {
-    if (paddle) {
-        paddle->clampToScreen();
+    containmentSystem(world, SpeedConfig::getPlayfield());
+}
+
+void Game::attachBallToPaddle() {
+    // Keep the ball positioned above the paddle when attached
+    Rectangle paddleRect = getPaddleRect();
+    Position& ball = world.get<Position>(ballEntity);
+    ball.x = paddleRect.x + paddleRect.width / 2;
+    ball.y = paddleRect.y - world.get<Collider>(ballEntity).radius;
+}
+
+PaddleInput Game::readPaddleInput() {
+    PaddleInput input = {0.0f, 0.0f};
+
+    // Handle keyboard input
+    if (IsKeyDown(KEY_LEFT)) input.axis -= 1.0f;
+    if (IsKeyDown(KEY_RIGHT)) input.axis += 1.0f;
+
+    // Skip touch processing if not available
+    if (!isTouchDevice) {
+        return input;
     }
-    if (ball) {
-        ball->clampToScreen();
+
+    // Using GESTURE_DRAG is better for paddle control than including GESTURE_TAP
+    if (IsGestureDetected(GESTURE_DRAG)) {
+        Vector2 touchPosition = GetTouchPosition(0); // Get the first touch point
+        
+        // Only control paddle if touch is in the lower half of the screen
+        // This prevents accidental paddle movement when trying to tap bricks
+        if (touchPosition.y > SpeedConfig::VIRTUAL_HEIGHT * 0.5f) {
+            // If this is the start of a new touch sequence
+            if (!touchActive) {
+                touchActive = true;
+                lastTouchX = touchPosition.x;
+            } else {
+                // Calculate movement based on touch difference
+                float touchDifference = touchPosition.x - lastTouchX;
+                if (fabs(touchDifference) > 1.0f) { // Small threshold to prevent tiny movements
+                    input.dragDelta = touchDifference;
+                    lastTouchX = touchPosition.x;
+                }
+            }
+        }
+    } else {
+        // No touch detected
+        touchActive = false;
     }
+    return input;
 }
 
 void Game::checkPaddleCollision() {
-    Vector2 ballPos = ball->getPosition();
-    float ballRadius = ball->getRadius();
-    Rectangle paddleRect = paddle->getRect();
-
-    if (CheckCollisionCircleRec(ballPos, ballRadius, paddleRect)) {
-        // Move ball above paddle to prevent sticking
-        ball->setPosition(ballPos.x, paddleRect.y - ballRadius);
-        
-        // Calculate hit position relative to paddle center (-1 to 1)
-        float hitPosition = (ballPos.x - (paddleRect.x + paddleRect.width / 2)) / (paddleRect.width / 2);
-        
-        // Calculate reflection angle based on hit position
-        float baseAngle = -PI / 2;  // Straight up
-        float maxAngleOffset = PI / 3;  // 60 degrees max deflection
-        float angle = baseAngle + (hitPosition * maxAngleOffset);
-        
-        // Calculate speed based on current ball speed
-        float currentSpeed = sqrt(ball->getSpeedX() * ball->getSpeedX() + 
-                                ball->getSpeedY() * ball->getSpeedY());
-        
-        // Set new velocity based on calculated angle
-        ball->setVelocity(angle, currentSpeed);
-        
-        // Add spin based on hit position and current paddle movement
-        float spinFactor = hitPosition;  // -1 to 1 based on hit position
-        if (IsKeyDown(KEY_LEFT)) spinFactor -= 0.5f;
-        if (IsKeyDown(KEY_RIGHT)) spinFactor += 0.5f;
-        ball->addSpin(spinFactor * 0.5f);
-        
+    float hitOffset = 0.0f;
+    if (resolveBallPaddle(world.get<Position>(ballEntity), world.get<Velocity>(ballEntity),
+                          world.get<Collider>(ballEntity), getPaddleRect(), paddleInput.axis, hitOffset)) {
+        rallyHits++;
+        telemetry.log(TelemetryEventType::PADDLE_HIT, static_cast<uint16_t>(rallyHits),
+                      static_cast<int32_t>(hitOffset * 1000.0f));
         validateGameObjects();
     }
 }
 
 void Game::checkBrickCollisions() {
-    for (auto& row : bricks) {
-        for (auto& brick : row) {
-            if (brick && brick->isAlive()) {
-                if (checkBallBrickCollision(brick->getRect())) {
-                    brick->destroy();
-                    score += 100;
-                    validateGameObjects();  // Ensure ball stays in bounds after collision
-                    return;
-                }
-            }
+    // Resolve against the lowest grid cell first to keep the row-major
+    // priority the full brick scan used to have
+    std::sort(brickCandidates.begin(), brickCandidates.end(), [this](Entity a, Entity b) {
+        return world.get<GridCell>(a).index < world.get<GridCell>(b).index;
+    });
+
+    Position& ballPosition = world.get<Position>(ballEntity);
+    Velocity& ballVelocity = world.get<Velocity>(ballEntity);
+    const Collider& ballCollider = world.get<Collider>(ballEntity);
+
+    for (Entity brick : brickCandidates) {
+        Rectangle brickRect = boxBounds(world.get<Position>(brick), world.get<Collider>(brick));
+        if (!resolveBallBrick(ballPosition, ballVelocity, ballCollider, brickRect, static_cast<uint32_t>(rand()))) {
+            continue;
         }
-    }
-}
 
-bool Game::checkBallBrickCollision(const Rectangle& brickRect) {
-    Vector2 ballPos = ball->getPosition();
-    float ballRadius = ball->getRadius();
+        telemetry.log(TelemetryEventType::BRICK_HIT, static_cast<uint16_t>(world.get<GridCell>(brick).index),
+                      static_cast<int32_t>(ballPosition.x), static_cast<int32_t>(ballPosition.y));
 
-    if (CheckCollisionCircleRec(ballPos, ballRadius, brickRect)) {
-        float brickCenterX = brickRect.x + brickRect.width / 2.0f;
-        float brickCenterY = brickRect.y + brickRect.height / 2.0f;
-        
-        float dx = ballPos.x - brickCenterX;
-        float dy = ballPos.y - brickCenterY;
-        
-        // Calculate normalized collision angle
-        float angle = atan2(dy, dx);
-        
-        // Calculate current ball speed
-        float currentSpeed = sqrt(ball->getSpeedX() * ball->getSpeedX() + 
-                                ball->getSpeedY() * ball->getSpeedY());
-        
-        // Add slight randomization to prevent chain reactions (±5 degrees)
-        float randomAngle = angle + (((float)rand() / RAND_MAX) * 0.174533f - 0.0872665f);
-        
-        // Determine if this is a corner collision
-        bool isCornerCollision = (fabs(dx) > brickRect.width * 0.4f && 
-                                fabs(dy) > brickRect.height * 0.4f);
-        
-        if (isCornerCollision) {
-            // For corner collisions, reflect based on the collision angle
-            ball->setVelocity(randomAngle, currentSpeed);
-            
-            // Add slight spin based on which corner was hit
-            float spinFactor = (dx > 0) ? 0.2f : -0.2f;
-            ball->addSpin(spinFactor);
-        } else {
-            // For edge collisions, use improved reflection
-            if (fabs(dx) * brickRect.height > fabs(dy) * brickRect.width) {
-                ball->reverseX();
-                // Add spin based on the vertical position of the hit
-                float spinFactor = (dy > 0) ? 0.1f : -0.1f;
-                ball->addSpin(spinFactor);
-            } else {
-                ball->reverseY();
-                // Add spin based on the horizontal position of the hit
-                float spinFactor = (dx > 0) ? -0.1f : 0.1f;
-                ball->addSpin(spinFactor);
-            }
+        Health& health = world.get<Health>(brick);
+        if (--health.hitPoints <= 0) {
+            score += health.scoreValue;
+            // Removed, not disabled: the entity index stored as user data gets reused
+            broadphase.remove(world.get<Collider>(brick).broadphaseHandle);
+            world.destroy(brick);
+            brickLayerDirty = true;
         }
-        
-        validateGameObjects();
-        return true;
+        validateGameObjects();  // Ensure ball stays in bounds after collision
+        return;
     }
-    return false;
 }
 
 void Game::update(float deltaTime) {
@@ -532,17 +343,26 @@ void Game::update(float deltaTime) {
     if (spacePressed || screenTapped) {
         if (state == GameState::START_SCREEN) {
             state = GameState::PLAYING;
+            logGameStart();
         }
         else if (state == GameState::GAME_OVER || state == GameState::WON) {
             reset();
             state = GameState::PLAYING;
+            logGameStart();
         }
         else if (state == GameState::PLAYING && ballAttached) {
             // Launch the ball when space is pressed or screen is tapped and the ball is attached
             ballAttached = false;
+            rallyHits = 0;
+            rallyStartMs = telemetry.getClockMs();
         }
     }
     
+    // Cycle through game modes from the start screen
+    if (state == GameState::START_SCREEN && IsKeyPressed(KEY_M)) {
+        setMode(static_cast<GameMode>((static_cast<int>(mode) + 1) % GAME_MODE_COUNT));
+    }
+    
     // Pause button via key or tap in top-right corner
     bool pausePressed = IsKeyPressed(KEY_P);
     bool pauseAreaTapped = false;
@@ -567,64 +387,354 @@ void Game::update(float deltaTime) {
     }
 
     if (state == GameState::PLAYING) {
-        paddle->update(deltaTime);
+#ifdef BREAKOUT_FIXED_POINT
+        updateFixedPlaying(deltaTime);
+#else
+        // Dispatch once per frame into the mode's compiled instantiation
+        std::visit([&](auto& field) { updatePlaying<ConfigOf<decltype(field)>>(deltaTime); }, bricks);
+#endif
+    }
+}
+
+template <typename Config>
+void Game::updatePlaying(float deltaTime) {
+    const Playfield playfield = SpeedConfig::getPlayfield();
+
+    paddleInput = readPaddleInput();
+    paddleInputSystem(world, paddleInput);
+    movementSystem(world, deltaTime, playfield);
+    containmentSystem(world, playfield);
+    
+    if (ballAttached) {
+        attachBallToPaddle();
+    } else {
+        ballSpeedTimer += deltaTime;
+        if (ballSpeedTimer >= Config::SPEED_INCREASE_INTERVAL) {
+            increaseSpeed(world.get<Velocity>(ballEntity), Config::BALL_SPEED_INCREMENT, Config::MAX_BALL_SPEED);
+            ballSpeedTimer = 0.0f;
+        }
         
-        if (ballAttached) {
-            // Keep the ball positioned above the paddle when attached
-            Rectangle paddleRect = paddle->getRect();
-            ball->setPosition(paddleRect.x + paddleRect.width / 2, paddleRect.y - ball->getRadius());
-        } else {
-            // Normal ball update when not attached
-            ball->update(deltaTime);
-            
-            ballSpeedTimer += deltaTime;
-            if (ballSpeedTimer >= SPEED_INCREASE_INTERVAL) {
-                ball->increaseSpeed(BALL_SPEED_INCREMENT);
-                ball->clampSpeed(MAX_BALL_SPEED);
-                ballSpeedTimer = 0.0f;
-            }
-            
+        updateBroadphase();
+        if (paddleCandidate) {
             checkPaddleCollision();
-            checkBrickCollisions();
-
-            if (ball->getPosition().y + ball->getRadius() > SpeedConfig::VIRTUAL_HEIGHT) {
-                lives--;
-                if (lives <= 0) {
-                    state = GameState::GAME_OVER;
-                    gameOver = true;
-                } else {
-                    resetBallAndPaddle();
-                    ballAttached = true;  // Reattach ball to paddle after life loss
-                }
+        }
+        checkBrickCollisions();
+
+        const Position& ball = world.get<Position>(ballEntity);
+        if (ball.y + world.get<Collider>(ballEntity).radius > playfield.height) {
+            lives--;
+            telemetry.log(TelemetryEventType::RALLY_END, static_cast<uint16_t>(rallyHits),
+                          static_cast<int32_t>(telemetry.getClockMs() - rallyStartMs));
+            telemetry.log(TelemetryEventType::LIFE_LOST, static_cast<uint16_t>(std::max(lives, 0)),
+                          static_cast<int32_t>(ball.x));
+            if (lives <= 0) {
+                state = GameState::GAME_OVER;
+                gameOver = true;
+                logGameEnd();
+            } else {
+                resetBallAndPaddle();
+                ballAttached = true;  // Reattach ball to paddle after life loss
             }
         }
+    }
 
-        validateGameObjects();
+    validateGameObjects();
+    checkLevelCleared();
+}
 
-        bool allBricksDestroyed = true;
-        for (const auto& row : bricks) {
-            for (const auto& brick : row) {
-                if (brick->isAlive()) {
-                    allBricksDestroyed = false;
-                    break;
-                }
-            }
-            if (!allBricksDestroyed) break;
-        }
-        if (allBricksDestroyed) {
+void Game::checkLevelCleared() {
+    if (world.archetype<BrickArchetype>().size() == 0) {
+        telemetry.log(TelemetryEventType::RALLY_END, static_cast<uint16_t>(rallyHits),
+                      static_cast<int32_t>(telemetry.getClockMs() - rallyStartMs));
+        if (mode == GameMode::ENDLESS) {
+            advanceLevel();
+        } else {
             state = GameState::WON;
             won = true;
+            logGameEnd();
         }
     }
 }
 
-void Game::draw() {
-    BeginDrawing();
+#ifdef BREAKOUT_FIXED_POINT
+void Game::restartFixedSimulation() {
+    const LevelDesign level = mode == GameMode::ENDLESS ? currentLevel : LevelDesign{mode, 0, 0, {}};
+    fixedSimulation = FixedSimulation(level, TARGET_FPS, static_cast<uint32_t>(rand()));
+    fixedAccumulator = 0.0f;
+    fixedScore = 0;
+}
+
+void Game::updateFixedPlaying(float deltaTime) {
+    paddleInput = readPaddleInput();
+    const float direction = paddleInput.axis != 0.0f ? paddleInput.axis : paddleInput.dragDelta;
+    const int axis = direction > 0.0f ? 1 : (direction < 0.0f ? -1 : 0);
+    const float step = 1.0f / TARGET_FPS;
+    const Playfield playfield = SpeedConfig::getPlayfield();
+
+    fixedAccumulator = std::min(fixedAccumulator + deltaTime, MAX_FIXED_STEPS * step);
+    if (ballAttached) {
+        // Aimed at the same fixed step, so the paddle moves at its playing speed
+        while (fixedAccumulator >= step) {
+            fixedAccumulator -= step;
+            fixedSimulation.aimServe(axis);
+        }
+        syncFixedSimulation();
+        return;
+    }
+
+    while (fixedAccumulator >= step) {
+        fixedAccumulator -= step;
+        // Telemetry positions are from before the step, like the float game's
+        // contact positions
+        const float ballX = fixedSimulation.getBallPosition().x.toFloat();
+        const float ballY = fixedSimulation.getBallPosition().y.toFloat();
+        const uint32_t events = fixedSimulation.step(axis);
+
+        if (events & SIM_EVENT_PADDLE) {
+            const float halfWidth = fixedSimulation.getPaddleWidth().half().toFloat();
+            const float hitOffset = (ballX - (fixedSimulation.getPaddleX().toFloat() + halfWidth)) / halfWidth;
+            rallyHits++;
+            telemetry.log(TelemetryEventType::PADDLE_HIT, static_cast<uint16_t>(rallyHits),
+                          static_cast<int32_t>(hitOffset * 1000.0f));
+        }
+        if (events & SIM_EVENT_BRICK) {
+            telemetry.log(TelemetryEventType::BRICK_HIT, static_cast<uint16_t>(fixedSimulation.getLastBrickHit()),
+                          static_cast<int32_t>(ballX * playfield.widthScale),
+                          static_cast<int32_t>(ballY * playfield.heightScale));
+        }
+        if (events & SIM_EVENT_LIFE_LOST) {
+            lives--;
+            telemetry.log(TelemetryEventType::RALLY_END, static_cast<uint16_t>(rallyHits),
+                          static_cast<int32_t>(telemetry.getClockMs() - rallyStartMs));
+            telemetry.log(TelemetryEventType::LIFE_LOST, static_cast<uint16_t>(std::max(lives, 0)),
+                          static_cast<int32_t>(ballX * playfield.widthScale));
+            if (lives <= 0) {
+                state = GameState::GAME_OVER;
+                gameOver = true;
+                logGameEnd();
+            } else {
+                resetBallAndPaddle();
+                ballAttached = true;  // The simulation has already served again
+            }
+            fixedAccumulator = 0.0f;
+            break;
+        }
+        if (fixedSimulation.isWon()) {
+            break;
+        }
+    }
+
+    score += fixedSimulation.getScore() - fixedScore;
+    fixedScore = fixedSimulation.getScore();
+    syncFixedSimulation();
+    checkLevelCleared();
+}
+
+// Copies positions and brick hit points; velocities in the world go unused
+void Game::syncFixedSimulation() {
+    const Playfield playfield = SpeedConfig::getPlayfield();
+    Position& paddle = world.get<Position>(paddleEntity);
+    paddle.x = fixedSimulation.getPaddleX().toFloat() * playfield.widthScale;
+    paddle.y = fixedSimulation.getPaddleY().toFloat() * playfield.heightScale;
+    Position& ball = world.get<Position>(ballEntity);
+    ball.x = fixedSimulation.getBallPosition().x.toFloat() * playfield.widthScale;
+    ball.y = fixedSimulation.getBallPosition().y.toFloat() * playfield.heightScale;
+
+    // Both index bricks by grid cell; collected first since destroying
+    // inside each() would move the rows being iterated
+    brickCandidates.clear();
+    world.each<Health, GridCell>([this](Entity entity, Health& health, GridCell& cell) {
+        health.hitPoints = fixedSimulation.getBrickHitPoints(cell.index);
+        if (health.hitPoints <= 0) {
+            brickCandidates.push_back(entity);
+        }
+    });
+    for (Entity brick : brickCandidates) {
+        broadphase.remove(world.get<Collider>(brick).broadphaseHandle);
+        world.destroy(brick);
+        brickLayerDirty = true;
+    }
+}
+#endif
+
+void Game::updateSceneTarget() {
+    int width = static_cast<int>(SpeedConfig::VIRTUAL_WIDTH * governor.getRenderScale());
+    int height = static_cast<int>(SpeedConfig::VIRTUAL_HEIGHT * governor.getRenderScale());
+
+    if (sceneTarget.id != 0 && sceneTarget.texture.width == width && sceneTarget.texture.height == height) {
+        return;
+    }
+    if (sceneTarget.id != 0) {
+        unloadRenderTarget(sceneTarget);
+    }
+
+    sceneTarget = loadRenderTarget(width, height);
+    SetTextureFilter(sceneTarget.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+void Game::updateQuality(float frameTime) {
+    governor.addFrame(frameTime, lastWorkTime);
+    if (governor.evaluate()) {
+        profiler.logEvent(governor.getLastDecision());
+
+        // Free the offscreen target as soon as we're back on the backbuffer
+        if (!governor.usesOffscreenTarget() && sceneTarget.id != 0) {
+            unloadRenderTarget(sceneTarget);
+        }
+    }
+
+    profiler.setStat("frame", TextFormat("%.2f ms (%d fps)", frameTime * 1000.0f, GetFPS()));
+    profiler.setStat("p95", TextFormat("%.2f frame, %.2f work / %.2f ms budget", governor.getP95FrameTime() * 1000.0f,
+                                       governor.getP95WorkTime() * 1000.0f, governor.getBudget() * 1000.0f));
+    profiler.setStat("quality", TextFormat("L%d %s", governor.getLevelIndex(), governor.getLevel().name));
+    profiler.setStat("internal res", TextFormat("%dx%d",
+                                                static_cast<int>(SpeedConfig::VIRTUAL_WIDTH * governor.getRenderScale()),
+                                                static_cast<int>(SpeedConfig::VIRTUAL_HEIGHT * governor.getRenderScale())));
+}
+
+void Game::updateBrickLayer() {
+    int width = static_cast<int>(SpeedConfig::VIRTUAL_WIDTH);
+    int height = static_cast<int>(SpeedConfig::VIRTUAL_HEIGHT);
+
+    if (brickLayer.id == 0 || brickLayer.texture.width != width || brickLayer.texture.height != height) {
+        if (brickLayer.id != 0) {
+            unloadRenderTarget(brickLayer);
+        }
+        brickLayer = loadRenderTarget(width, height);
+        brickLayerDirty = true;
+    }
+
+    if (!brickLayerDirty) {
+        return;
+    }
+
+    // Must run outside any other BeginTextureMode since raylib can't nest them
+    brickCommands.clear();
+    renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, brickCommands);
+
+    BeginTextureMode(brickLayer);
+    ClearBackground(BLANK);
+    brickCommands.submit(nullptr);
+    EndTextureMode();
+
+    brickLayerDirty = false;
+    brickLayerRepaints++;
+}
+
+// Visual regression check for SoftwareRasterizer: the scene drawn by raylib
+// at full resolution and box-filtered down should match the CPU frame.
+// Runs between frames, since raylib can't nest texture modes.
+void Game::compareSoftwareRaster() {
+    constexpr int TOLERANCE = 8;
+    constexpr float MAX_SUPERSAMPLING = 4.0f;
+    const float scale = std::min({1.0f, MAX_SUPERSAMPLING * RASTER_CHECK_WIDTH / SpeedConfig::VIRTUAL_WIDTH,
+                                  MAX_SUPERSAMPLING * RASTER_CHECK_HEIGHT / SpeedConfig::VIRTUAL_HEIGHT});
+    const int width = static_cast<int>(SpeedConfig::VIRTUAL_WIDTH * scale);
+    const int height = static_cast<int>(SpeedConfig::VIRTUAL_HEIGHT * scale);
+
+    if (rasterTarget.id == 0 || rasterTarget.texture.width != width || rasterTarget.texture.height != height) {
+        if (rasterTarget.id != 0) {
+            unloadRenderTarget(rasterTarget);
+        }
+        rasterTarget = loadRenderTarget(width, height);
+    }
+    rasterReadback.resize(static_cast<size_t>(width) * height * 4);
+    rasterDownsampled.resize(static_cast<size_t>(RASTER_CHECK_WIDTH) * RASTER_CHECK_HEIGHT * 4);
+    rasterReference.resize(rasterizer.getFrameSize());
+    rasterPixels.resize(rasterizer.getFrameSize());
+
+    rasterCommands.clear();
+    renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, rasterCommands);
+    renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, rasterCommands);
+    Camera2D scaled{};
+    scaled.zoom = scale;
+    BeginTextureMode(rasterTarget);
     ClearBackground(BLACK);
+    BeginMode2D(scaled);
+    rasterCommands.submit(nullptr);
+    EndMode2D();
+    // Read straight into the kept buffer instead of through an Image
+    rlDrawRenderBatchActive();
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rasterReadback.data());
+    EndTextureMode();
+
+    SoftwareRasterizer::downsample(rasterReadback.data(), width, height, 4, rasterDownsampled.data(),
+                                   RASTER_CHECK_WIDTH, RASTER_CHECK_HEIGHT);
+    // Render textures are stored bottom-up
+    for (int y = 0; y < RASTER_CHECK_HEIGHT; y++) {
+        const uint8_t* source = &rasterDownsampled[static_cast<size_t>(RASTER_CHECK_HEIGHT - 1 - y) *
+                                                   RASTER_CHECK_WIDTH * 4];
+        uint8_t* target = &rasterReference[static_cast<size_t>(y) * RASTER_CHECK_WIDTH * 3];
+        for (int x = 0; x < RASTER_CHECK_WIDTH; x++) {
+            target[x * 3] = source[x * 4];
+            target[x * 3 + 1] = source[x * 4 + 1];
+            target[x * 3 + 2] = source[x * 4 + 2];
+        }
+    }
 
-    // Update camera before drawing
-    updateCamera();
-    BeginMode2D(camera);
+    rasterizer.setSourceSize(SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT);
+    rasterizer.renderWorld(world, rasterPixels.data());
+
+    const SoftwareRasterizer::Difference difference =
+        SoftwareRasterizer::compare(rasterPixels.data(), rasterReference.data(), rasterPixels.size(), TOLERANCE);
+    profiler.logEvent(TextFormat("raster diff: mean %.2f, max %d, %.1f%% within %d", difference.meanError,
+                                 difference.maxError, difference.withinTolerance * 100.0, TOLERANCE));
+    needsRedraw = true;
+}
+
+void Game::draw() {
+    const double drawStart = GetTime();
+    updateBrickLayer();
+
+    if (governor.usesOffscreenTarget()) {
+        updateSceneTarget();
+
+        // Render at the reduced internal resolution; the camera zoom maps
+        // screen-space game coordinates onto the smaller target
+        BeginTextureMode(sceneTarget);
+        ClearBackground(BLACK);
+        camera.zoom = governor.getRenderScale();
+        BeginMode2D(camera);
+        drawScene();
+        EndMode2D();
+        EndTextureMode();
+
+        // Upscale to the canvas (render textures are stored upside down)
+        BeginDrawing();
+        ClearBackground(BLACK);
+        Rectangle source = { 0, 0, static_cast<float>(sceneTarget.texture.width),
+                             -static_cast<float>(sceneTarget.texture.height) };
+        Rectangle dest = { 0, 0, SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT };
+        DrawTexturePro(sceneTarget.texture, source, dest, Vector2{0, 0}, 0.0f, WHITE);
+    } else {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        camera.zoom = 1.0f;
+        BeginMode2D(camera);
+        drawScene();
+        EndMode2D();
+    }
+
+    if (spectatorVisible) {
+        drawSpectatorView();
+    }
+
+    profiler.draw();
+    // EndDrawing may wait for the frame deadline, so only the submission counts
+    const double submitted = GetTime();
+    scheduler.addDrawCost(submitted - drawStart);
+    // Deferred tasks only fill time the frame had spare, so they don't count;
+    // whatever they ran past the deadline does (FrameScheduler::runPending)
+    lastWorkTime = static_cast<float>(submitted - frameStart - deferredTime);
+    EndDrawing();
+}
+
+// Records the frame into a command list. Only reads game state and measures
+// text (CPU side), so it could run on a thread other than the GL one.
+// snprintf instead of TextFormat, whose buffers are shared.
+void Game::buildRenderCommands(RenderCommandBuffer& commands) const {
+    commands.clear();
+    char text[64];
 
     // Calculate font sizes relative to screen height with a maximum size
     const float maxFontSize = SpeedConfig::VIRTUAL_HEIGHT * 0.067f;
@@ -637,74 +747,68 @@ void Game::draw() {
     const float maxHUDTextSize = SpeedConfig::VIRTUAL_HEIGHT * 0.05f;  // Maximum 5% of screen height
     const float hudTextSize = std::min(scaledTextSize, maxHUDTextSize);
 
+    // Centred text, shrunk to fit 80% of the screen width when scaleToFit is set
+    auto addCenteredText = [&](DrawLayer layer, const char* message, float y, float size, Color color, bool scaleToFit) {
+        float scale = 1.0f;
+        int width = MeasureText(message, static_cast<int>(size));
+        if (scaleToFit && width > SpeedConfig::VIRTUAL_WIDTH * 0.8f) {
+            scale = (SpeedConfig::VIRTUAL_WIDTH * 0.8f) / width;
+        }
+        commands.addText(layer, message, (SpeedConfig::VIRTUAL_WIDTH - width * scale) / 2, y, size * scale, color);
+    };
+
+    // Field, paddle and ball show behind every in-game state
+    if (state != GameState::START_SCREEN) {
+        commands.addRenderTexture(DrawLayer::SCENE, SLOT_BRICK_LAYER,
+                                  Rectangle{0, 0, SpeedConfig::VIRTUAL_WIDTH, SpeedConfig::VIRTUAL_HEIGHT}, WHITE);
+        renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, commands);
+    }
+
     switch (state) {
         case GameState::START_SCREEN: {
-            const char* title = "BREAKOUT";
-            const char* instructions = isTouchDevice ? 
-                "Press SPACE or TAP to Start" : 
-                "Press SPACE to Start";
-
-            // Ensure text fits within screen width
-            float titleScale = 1.0f;
-            int titleWidth = MeasureText(title, fontSize);
-            if (titleWidth > SpeedConfig::VIRTUAL_WIDTH * 0.8f) {
-                titleScale = (SpeedConfig::VIRTUAL_WIDTH * 0.8f) / titleWidth;
+            addCenteredText(DrawLayer::MESSAGES, "BREAKOUT", SpeedConfig::VIRTUAL_HEIGHT / 3, fontSize, WHITE, true);
+            addCenteredText(DrawLayer::HUD, isTouchDevice ? "Press SPACE or TAP to Start" : "Press SPACE to Start",
+                            SpeedConfig::VIRTUAL_HEIGHT / 2, smallFontSize, GRAY, false);
+
+            const char* modeName = std::visit([](const auto& field) { return ConfigOf<decltype(field)>::NAME; }, bricks);
+            snprintf(text, sizeof(text), "Mode: %s (M to change)", modeName);
+            addCenteredText(DrawLayer::HUD, text, SpeedConfig::VIRTUAL_HEIGHT * 0.42f, smallFontSize, SKYBLUE, false);
+
+            if (saves.getBestScore(mode) > 0) {
+                if (mode == GameMode::ENDLESS) {
+                    snprintf(text, sizeof(text), "Best: %d (level %d)", saves.getBestScore(mode),
+                             static_cast<int>(saves.getData().bestLevel));
+                } else {
+                    snprintf(text, sizeof(text), "Best: %d", saves.getBestScore(mode));
+                }
+                addCenteredText(DrawLayer::HUD, text, SpeedConfig::VIRTUAL_HEIGHT * 0.55f, smallFontSize, GOLD, false);
             }
-
-            DrawText(title,
-                    (SpeedConfig::VIRTUAL_WIDTH - titleWidth * titleScale) / 2,
-                    SpeedConfig::VIRTUAL_HEIGHT / 3,
-                    fontSize * titleScale, WHITE);
-
-            int instructionsWidth = MeasureText(instructions, smallFontSize);
-            DrawText(instructions,
-                    (SpeedConfig::VIRTUAL_WIDTH - instructionsWidth) / 2,
-                    SpeedConfig::VIRTUAL_HEIGHT / 2,
-                    smallFontSize, GRAY);
                     
             // Add mobile controls instructions only if touch is available
             if (isTouchDevice) {
-                const char* mobileInstructions = "DRAG to move paddle | TAP to launch ball";
-                int mobileTextWidth = MeasureText(mobileInstructions, smallFontSize * 0.8f);
-                DrawText(mobileInstructions,
-                        (SpeedConfig::VIRTUAL_WIDTH - mobileTextWidth) / 2,
-                        SpeedConfig::VIRTUAL_HEIGHT * 0.6f,
-                        smallFontSize * 0.8f, GRAY);
+                addCenteredText(DrawLayer::HUD, "DRAG to move paddle | TAP to launch ball",
+                                SpeedConfig::VIRTUAL_HEIGHT * 0.6f, smallFontSize * 0.8f, GRAY, false);
             }
             break;
         }
 
         case GameState::PLAYING:
         case GameState::PAUSED: {
-            paddle->draw();
-            ball->draw();
-
             // Draw a launch prompt when ball is attached
             if (ballAttached && state == GameState::PLAYING) {
-                const char* launchText = isTouchDevice ? 
-                    "Press SPACE or TAP to launch" : 
-                    "Press SPACE to launch";
-                int textWidth = MeasureText(launchText, smallFontSize);
-                DrawText(launchText,
-                        (SpeedConfig::VIRTUAL_WIDTH - textWidth) / 2,
-                        SpeedConfig::VIRTUAL_HEIGHT * 0.7f,
-                        smallFontSize, YELLOW);
-            }
-
-            for (const auto& row : bricks) {
-                for (const auto& brick : row) {
-                    brick->draw();
-                }
+                addCenteredText(DrawLayer::HUD, isTouchDevice ? "Press SPACE or TAP to launch" : "Press SPACE to launch",
+                                SpeedConfig::VIRTUAL_HEIGHT * 0.7f, smallFontSize, YELLOW, false);
             }
 
             // Draw score and lives with padding from screen edges
             const float edgePadding = SpeedConfig::VIRTUAL_WIDTH * 0.02f;
-            const char* scoreText = TextFormat("Score: %d", score);
-            const char* livesText = TextFormat("Lives: %d", lives);
+            char livesText[32];
+            snprintf(text, sizeof(text), "Score: %d", score);
+            snprintf(livesText, sizeof(livesText), "Lives: %d", lives);
             
             // Calculate text widths for positioning
-            int scoreWidth = MeasureText(scoreText, hudTextSize);
-            int livesWidth = MeasureText(livesText, hudTextSize);
+            int scoreWidth = MeasureText(text, static_cast<int>(hudTextSize));
+            int livesWidth = MeasureText(livesText, static_cast<int>(hudTextSize));
             
             // Ensure text doesn't overlap by adjusting position if needed
             float scoreX = edgePadding;
@@ -719,8 +823,13 @@ void Game::draw() {
                 livesX = scoreX + scoreWidth + minSpacing;
             }
             
-            DrawText(scoreText, scoreX, edgePadding, hudTextSize, WHITE);
-            DrawText(livesText, livesX, edgePadding, hudTextSize, WHITE);
+            commands.addText(DrawLayer::HUD, text, scoreX, edgePadding, hudTextSize, WHITE);
+            commands.addText(DrawLayer::HUD, livesText, livesX, edgePadding, hudTextSize, WHITE);
+
+            if (mode == GameMode::ENDLESS) {
+                snprintf(text, sizeof(text), "Level %d", currentLevel.number);
+                addCenteredText(DrawLayer::HUD, text, edgePadding, hudTextSize, SKYBLUE, false);
+            }
             
             // Draw pause button for touch screens only if touch is available
             if (isTouchDevice) {
@@ -732,7 +841,7 @@ void Game::draw() {
                 };
                 
                 // Draw pause button with slight transparency
-                DrawRectangleRec(pauseButtonRect, ColorAlpha(DARKGRAY, 0.7f));
+                commands.addRectangle(DrawLayer::CONTROLS, pauseButtonRect, ColorAlpha(DARKGRAY, 0.7f));
                 
                 // Calculate position for pause icon
                 float pauseIconSize = pauseButtonRect.width * 0.5f;
@@ -744,31 +853,18 @@ void Game::draw() {
                 float lineHeight = pauseIconSize;
                 float spacing = pauseIconSize * 0.3f;
                 
-                DrawRectangle(pauseX, pauseY, lineWidth, lineHeight, WHITE);
-                DrawRectangle(pauseX + lineWidth + spacing, pauseY, lineWidth, lineHeight, WHITE);
+                commands.addRectangle(DrawLayer::CONTROLS, Rectangle{pauseX, pauseY, lineWidth, lineHeight}, WHITE);
+                commands.addRectangle(DrawLayer::CONTROLS,
+                                      Rectangle{pauseX + lineWidth + spacing, pauseY, lineWidth, lineHeight}, WHITE);
             }
 
             if (state == GameState::PAUSED) {
-                const char* pausedText = "PAUSED";
-                float textScale = 1.0f;
-                int textWidth = MeasureText(pausedText, fontSize);
-                if (textWidth > SpeedConfig::VIRTUAL_WIDTH * 0.8f) {
-                    textScale = (SpeedConfig::VIRTUAL_WIDTH * 0.8f) / textWidth;
-                }
-
-                DrawText(pausedText,
-                        (SpeedConfig::VIRTUAL_WIDTH - textWidth * textScale) / 2,
-                        SpeedConfig::VIRTUAL_HEIGHT / 2,
-                        fontSize * textScale, YELLOW);
+                addCenteredText(DrawLayer::MESSAGES, "PAUSED", SpeedConfig::VIRTUAL_HEIGHT / 2, fontSize, YELLOW, true);
                         
                 // Add tap instructions to resume only if touch is available
                 if (isTouchDevice) {
-                    const char* tapToResume = "Tap in pause area to resume";
-                    int resumeWidth = MeasureText(tapToResume, smallFontSize);
-                    DrawText(tapToResume,
-                            (SpeedConfig::VIRTUAL_WIDTH - resumeWidth) / 2,
-                            SpeedConfig::VIRTUAL_HEIGHT * 0.6f,
-                            smallFontSize, GRAY);
+                    addCenteredText(DrawLayer::MESSAGES, "Tap in pause area to resume",
+                                    SpeedConfig::VIRTUAL_HEIGHT * 0.6f, smallFontSize, GRAY, false);
                 }
             }
             break;
@@ -776,36 +872,80 @@ void Game::draw() {
 
         case GameState::GAME_OVER:
         case GameState::WON: {
-            paddle->draw();
-            ball->draw();
-            for (const auto& row : bricks) {
-                for (const auto& brick : row) {
-                    brick->draw();
-                }
-            }
-
-            const char* text = state == GameState::GAME_OVER ?
+            const char* message = state == GameState::GAME_OVER ?
                 (isTouchDevice ? "Game Over! Tap to restart" : "Game Over! Press SPACE to restart") :
                 (isTouchDevice ? "You Won! Tap to restart" : "You Won! Press SPACE to restart");
+            addCenteredText(DrawLayer::MESSAGES, message, SpeedConfig::VIRTUAL_HEIGHT / 2, fontSize,
+                            state == GameState::GAME_OVER ? RED : GREEN, true);
 
-            // Calculate text scale to ensure it fits
-            float textScale = 1.0f;
-            int textWidth = MeasureText(text, fontSize);
-            if (textWidth > SpeedConfig::VIRTUAL_WIDTH * 0.8f) {
-                textScale = (SpeedConfig::VIRTUAL_WIDTH * 0.8f) / textWidth;
+            if (newHighScore) {
+                snprintf(text, sizeof(text), "New high score: %d", score);
+                addCenteredText(DrawLayer::MESSAGES, text, SpeedConfig::VIRTUAL_HEIGHT * 0.6f, smallFontSize, GOLD, false);
             }
-
-            DrawText(text,
-                    (SpeedConfig::VIRTUAL_WIDTH - textWidth * textScale) / 2,
-                    SpeedConfig::VIRTUAL_HEIGHT / 2,
-                    fontSize * textScale,
-                    state == GameState::GAME_OVER ? RED : GREEN);
             break;
         }
     }
 
-    EndMode2D();
-    EndDrawing();
+    commands.sort();
+}
+
+void Game::drawScene() {
+    const Texture2D textureSlots[] = { brickLayer.texture };
+    frameCommands.submit(textureSlots);
+}
+
+void Game::logGameStart() {
+    gameStartMs = telemetry.getClockMs();
+    telemetry.log(TelemetryEventType::GAME_START, static_cast<uint16_t>(mode));
+}
+
+void Game::logGameEnd() {
+    telemetry.log(TelemetryEventType::GAME_END, won ? 1 : 0, score,
+                  static_cast<int32_t>(telemetry.getClockMs() - gameStartMs));
+    newHighScore = saves.recordGame(mode, score, mode == GameMode::ENDLESS ? currentLevel.number : 0);
+}
+
+// Saved settings arrive a few frames in; only the start screen adopts them
+void Game::applySavedSettings() {
+    const SaveData& saved = saves.getData();
+    if (state == GameState::START_SCREEN && static_cast<GameMode>(saved.mode) != mode) {
+        setMode(static_cast<GameMode>(saved.mode));
+    }
+    if ((saved.profilerVisible != 0) != profiler.isVisible()) {
+        profiler.toggle();
+    }
+    renderCommandsDirty = true;
+    needsRedraw = true;
+}
+
+// Level 1 is small and validates in milliseconds, so waiting for it is fine
+void Game::startEndless() {
+    levels.start(static_cast<uint32_t>(time(nullptr)));
+    currentLevel = levels.take();
+}
+
+void Game::advanceLevel() {
+    // Normally queued long ago; only a very quick clear can catch up with it
+    if (!levels.tryTake(currentLevel)) {
+        profiler.logEvent("level queue empty, waiting");
+        currentLevel = levels.take();
+    }
+    initializeBricks();
+    resetBallAndPaddle();
+    ballAttached = true;
+}
+
+void Game::setMode(GameMode newMode) {
+    mode = newMode;
+    saves.setMode(mode);
+    if (mode == GameMode::ENDLESS) {
+        startEndless();
+    }
+    initializeBricks();
+    resetBallAndPaddle();
+    ballAttached = true;
+    renderCommandsDirty = true;
+    needsRedraw = true;
 }
 
 void Game::reset() {
@@ -817,10 +957,306 @@ void Game::reset() {
     lives = INITIAL_LIVES;
     
     resetBallAndPaddle();
+    if (mode == GameMode::ENDLESS) {
+        startEndless();
+    }
     initializeBricks();
 }
 
+bool Game::isIdleState() const {
+    return state != GameState::PLAYING;
+}
+
+void Game::waitForInput() {
+#ifdef __EMSCRIPTEN__
+    // WaitTime busy-waits on the web; emscripten_sleep yields to the browser (ASYNCIFY)
+    emscripten_sleep(static_cast<unsigned int>(IDLE_TICK * 1000.0f));
+#else
+    WaitTime(IDLE_TICK);
+#endif
+    // EndDrawing normally polls input; skipped frames have to do it themselves
+    PollInputEvents();
+}
+
+// Idle ticks change nothing on screen, so only drawn frames are broadcast
+void Game::broadcastSpectatorFrame() {
+    MemoryScope scope(MemoryTag::SPECTATOR);
+    SpectatorState frame{};
+    frame.tick = spectatorTick++;
+    frame.mode = mode;
+    frame.phase = static_cast<uint8_t>(state);
+    frame.score = score;
+    frame.lives = lives;
+    frame.level = mode == GameMode::ENDLESS ? currentLevel.number : 0;
+    frame.width = SpeedConfig::VIRTUAL_WIDTH;
+    frame.height = SpeedConfig::VIRTUAL_HEIGHT;
+    captureSpectatorState(world, mode == GameMode::ENDLESS ? currentLevel.hitPoints : std::vector<uint8_t>(), frame);
+
+    const double encodeStart = GetTime();
+    spectatorMessage.clear();
+    spectatorEncoder.encode(frame, spectatorMessage);
+    spectatorWindowEncode += GetTime() - encodeStart;
+    spectatorWindowBytes += spectatorMessage.size();
+    spectatorWindowTicks++;
+
+    // Through the loopback link and out the other end
+    if (spectatorVisible) {
+        spectatorWire.clear();
+        frameMessage(spectatorMessage, spectatorWire);
+        spectatorLink.feed(spectatorWire.data(), spectatorWire.size());
+
+        const double decodeStart = GetTime();
+        while (spectatorLink.next(spectatorMessage)) {
+            if (spectatorDecoder.decode(spectatorMessage.data(), spectatorMessage.size())) {
+                spectatorView.apply(spectatorDecoder.getState());
+            }
+        }
+        spectatorWindowDecode += GetTime() - decodeStart;
+    }
+
+    const double now = GetTime();
+    if (now - spectatorWindowStart >= 1.0) {
+        const double ticks = spectatorWindowTicks > 0 ? spectatorWindowTicks : 1;
+        snprintf(spectatorSummary, sizeof(spectatorSummary), "%.0f B/s, %.1f us enc, %.1f us dec, %llu keys",
+                 spectatorWindowBytes / (now - spectatorWindowStart), spectatorWindowEncode * 1e6 / ticks,
+                 spectatorWindowDecode * 1e6 / ticks,
+                 static_cast<unsigned long long>(spectatorEncoder.getKeyframes()));
+        spectatorWindowStart = now;
+        spectatorWindowBytes = 0;
+        spectatorWindowEncode = 0.0;
+        spectatorWindowDecode = 0.0;
+        spectatorWindowTicks = 0;
+    }
+    profiler.setStat("spectator", spectatorSummary);
+}
+
+// Quarter-size picture-in-picture in the bottom-right corner
+void Game::drawSpectatorView() {
+    const float width = SpeedConfig::VIRTUAL_WIDTH * 0.25f;
+    const float height = SpeedConfig::VIRTUAL_HEIGHT * 0.25f;
+    const float margin = SpeedConfig::VIRTUAL_WIDTH * 0.01f;
+    const Rectangle frame{SpeedConfig::VIRTUAL_WIDTH - width - margin, SpeedConfig::VIRTUAL_HEIGHT - height - margin,
+                          width, height};
+    DrawRectangleRec(frame, BLACK);
+    DrawRectangleLinesEx(frame, 1.0f, GRAY);
+    if (!spectatorView.hasState()) {
+        DrawText("waiting for keyframe", static_cast<int>(frame.x) + 4, static_cast<int>(frame.y) + 4, 10, GRAY);
+        return;
+    }
+
+    MemoryScope scope(MemoryTag::SPECTATOR);
+    const SpectatorState& view = spectatorView.getState();
+    Camera2D viewCamera{};
+    viewCamera.offset = Vector2{frame.x, frame.y};
+    viewCamera.zoom = width / view.width;
+    spectatorCommands.clear();
+    spectatorView.buildRenderCommands(spectatorCommands);
+    spectatorCommands.sort();
+
+    BeginScissorMode(static_cast<int>(frame.x), static_cast<int>(frame.y), static_cast<int>(width),
+                     static_cast<int>(height));
+    BeginMode2D(viewCamera);
+    spectatorCommands.submit(nullptr);
+    EndMode2D();
+    EndScissorMode();
+
+    DrawText(TextFormat("spectator  score %d  lives %d  tick %u", view.score, view.lives, view.tick),
+             static_cast<int>(frame.x) + 4, static_cast<int>(frame.y) + 4, 10, LIGHTGRAY);
+}
+
+void Game::addDeferredTasks() {
+    using Priority = FrameScheduler::Priority;
+    using Phase = FrameScheduler::Phase;
+    // Loading changes settings on screen, so it goes before the frame is
+    // recorded; the rest is kept off the frame that caused it
+    saveLoadTask = scheduler.addTask("save load", Priority::HIGH, Phase::BEFORE_DRAW, 0.0, [this](double) {
+        if (saves.poll()) {
+            if (saves.ignoredUnreadableFile()) {
+                profiler.logEvent("save file unreadable, using defaults");
+            }
+            applySavedSettings();
+        }
+        return false;
+    });
+    levelTask = scheduler.addTask("level pump", Priority::NORMAL, Phase::AFTER_DRAW, LEVEL_PUMP_SLICE,
+                                  [this](double budget) {
+                                      levels.pump(budget);
+                                      return false;
+                                  });
+    telemetryTask = scheduler.addTask("telemetry flush", Priority::LOW, Phase::AFTER_DRAW, 0.0, [this](double) {
+        telemetry.flush();
+        return false;
+    });
+    saveWriteTask = scheduler.addTask("save write", Priority::LOW, Phase::AFTER_DRAW, 0.0, [this](double) {
+        saves.flush();
+        return false;
+    });
+}
+
+// Marks the deferrable work that is due; the scheduler decides when it runs
+void Game::requestDeferredWork() {
+    const bool idle = isIdleState();
+    if (!saves.isLoaded()) {
+        scheduler.request(saveLoadTask);
+    }
+    if (mode == GameMode::ENDLESS) {
+        scheduler.request(levelTask);
+    }
+    // Batches during play; whatever is left once play stops
+    if (telemetry.shouldFlush() || (idle && telemetry.getPending() > 0)) {
+        scheduler.request(telemetryTask);
+    }
+    // Storage syncs stall, so saves wait until play stops
+    if (idle && saves.hasPendingWrite()) {
+        scheduler.request(saveWriteTask);
+    }
+}
+
+void Game::publishSchedulerStats() {
+    profiler.setStat("scheduler", TextFormat("%.2f ms free, %.2f ms work, %.2f ms draw, %d run, %d deferred",
+                                             scheduler.getLastBudget() * 1000.0, scheduler.getWorkCost() * 1000.0,
+                                             scheduler.getDrawCost() * 1000.0, scheduler.getLastRunCount(),
+                                             scheduler.getLastDeferredCount()));
+    for (int task = 0; task < scheduler.getTaskCount(); task++) {
+        const FrameScheduler::TaskStats& stats = scheduler.getTaskStats(task);
+        profiler.setStat(scheduler.getTaskName(task),
+                         TextFormat("%.2f ms avg, %.2f max, %u runs, %u deferred, %u forced",
+                                    stats.averageSeconds * 1000.0, stats.maxSeconds * 1000.0, stats.runs,
+                                    stats.deferrals, stats.forcedRuns));
+    }
+}
+
+void Game::publishMemoryStats() {
+    MemoryTracker::refresh();
+    const size_t heapPeak = MemoryTracker::getHeapPeak();
+    constexpr double MB = 1024.0 * 1024.0;
+    profiler.setStat("heap", TextFormat("%.2f MB in use, %.2f peak, %.0f MB heap", MemoryTracker::getHeapInUse() / MB,
+                                        heapPeak / MB, MemoryTracker::getHeapSize() / MB));
+
+    // Play shouldn't allocate, so a new high while playing is worth a line
+    if (state != GameState::PLAYING) {
+        reportedHeapPeak = heapPeak;
+    } else if (heapPeak > reportedHeapPeak + HEAP_GROWTH_REPORT) {
+        profiler.logEvent(TextFormat("heap peak %.0f KB while playing", heapPeak / 1024.0));
+        reportedHeapPeak = heapPeak;
+    }
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        const MemoryTracker::Usage usage = MemoryTracker::getUsage(static_cast<MemoryTag>(tag));
+        if (usage.peak > 0) {
+            profiler.setStat(MemoryTracker::getName(static_cast<MemoryTag>(tag)),
+                             TextFormat("%.1f KB, peak %.1f KB", usage.current / 1024.0, usage.peak / 1024.0));
+        }
+    }
+}
+
 void Game::run() {
-    update(GetFrameTime());
+    frameStart = GetTime();
+    deferredTime = 0.0;
+    scheduler.beginFrame();
+    telemetry.setClock(GetTime());
+
+    // I/O requested last frame, now that the frame is on screen (EndDrawing
+    // was the last thing the previous call did)
+    deferredTime += scheduler.runAfterDraw();
+    // Update and recording, which the next runAfterDraw reserves
+    double workStart = GetTime();
+    double workTime = 0.0;
+
+    if (IsKeyPressed(KEY_F3)) {
+        profiler.toggle();
+        saves.setProfilerVisible(profiler.isVisible());
+        needsRedraw = true;
+    }
+    if (IsKeyPressed(KEY_F4)) {
+        compareSoftwareRaster();
+    }
+    if (IsKeyPressed(KEY_F5)) {
+        // A fresh spectator joins at the next keyframe, which is sent right away
+        MemoryScope scope(MemoryTag::SPECTATOR);
+        spectatorVisible = !spectatorVisible;
+        spectatorDecoder = SpectatorDecoder();
+        spectatorEncoder.requestKeyframe();
+        needsRedraw = true;
+    }
+
+    // Catch size changes that didn't come through setWindowSize or IsWindowResized
+    if (GetScreenWidth() != static_cast<int>(SpeedConfig::VIRTUAL_WIDTH) ||
+        GetScreenHeight() != static_cast<int>(SpeedConfig::VIRTUAL_HEIGHT)) {
+        updateCamera();
+    }
+
+    // Raylib measures frame time between EndDrawing calls, so the first frame
+    // after an idle stretch reports the whole stretch
+    const float frameTime = skippedLastFrame ? std::min(GetFrameTime(), MAX_FRAME_TIME) : GetFrameTime();
+
+    GameState previousState = state;
+    update(frameTime);
+    if (state != previousState) {
+        renderCommandsDirty = true;
+        needsRedraw = true;
+    }
+
+    requestDeferredWork();
+
+    if (isIdleState() && !needsRedraw) {
+        // Idle time is free time: drain anything left queued (e.g. storage wasn't ready)
+        scheduler.runIdle(IDLE_TASK_BUDGET);
+        idleFramesSkipped++;
+        skippedLastFrame = true;
+        waitForInput();
+        return;
+    }
+
+    // Frame times that span an idle stretch would mislead the governor
+    if (!skippedLastFrame) {
+        updateQuality(frameTime);
+    }
+    profiler.setStat("idle skipped", TextFormat("%d frames", idleFramesSkipped));
+    profiler.setStat("brick repaints", TextFormat("%d", brickLayerRepaints));
+    profiler.setStat("broadphase", TextFormat("%d bodies, %d swaps, %d candidates",
+                                              broadphase.getBodyCount(), broadphase.getLastSortSwaps(),
+                                              static_cast<int>(brickCandidates.size()) + (paddleCandidate ? 1 : 0)));
+
+    if (mode == GameMode::ENDLESS) {
+        const LevelQueue::Stats levelStats = levels.getStats();
+        profiler.setStat("levels", TextFormat("%d ready, %d/%d accepted, %.1f/s, %d workers",
+                                              levelStats.ready, levelStats.accepted, levelStats.candidates,
+                                              levelStats.levelsPerSecond, levels.getWorkerCount()));
+    }
+
+    profiler.setStat("saves", TextFormat("%s, %u writes, %u failed%s", saves.isLoaded() ? "loaded" : "loading",
+                                         saves.getWrites(), saves.getFailedWrites(),
+                                         saves.hasPendingWrite() ? ", pending" : ""));
+
+    profiler.setStat("telemetry", TextFormat("%u pending, %u written, %u dropped, %u failed writes",
+                                             telemetry.getPending(), telemetry.getWritten(), telemetry.getDropped(),
+                                             telemetry.getFailedWrites()));
+
+    broadcastSpectatorFrame();
+
+    // Work that may change what is on screen (saved settings) gets what the
+    // frame has left after drawing is reserved, before the frame is recorded
+    workTime += GetTime() - workStart;
+    deferredTime += scheduler.run();
+    workStart = GetTime();
+    publishSchedulerStats();
+    publishMemoryStats();
+
+    // While playing everything moves; otherwise the last list is replayed
+    // until something visible changes
+    if (state == GameState::PLAYING || renderCommandsDirty) {
+        buildRenderCommands(frameCommands);
+        renderCommandsDirty = false;
+    } else {
+        renderCommandReuses++;
+    }
+    scheduler.addWorkCost(workTime + GetTime() - workStart);
+    profiler.setStat("render commands", TextFormat("%d (%d switches), %d reused",
+                                                   static_cast<int>(frameCommands.size()),
+                                                   frameCommands.getPrimitiveSwitches(), renderCommandReuses));
+
     draw();
+    needsRedraw = false;
+    skippedLastFrame = false;
 }
@@ -0,0 +1,313 @@
+#include "../include/level_generator.h"
+#include "../include/memory_tracker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Emscripten only has threads when built with -pthread (BREAKOUT_THREADS)
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define LEVEL_QUEUE_THREADS 1
+#else
+#define LEVEL_QUEUE_THREADS 0
+#endif
+
+namespace {
+    using Layout = BrickLayout<EndlessConfig>;
+
+    enum class DensityCurve { FLAT, TOP_HEAVY, BOTTOM_HEAVY, BANDS, HOURGLASS, COUNT };
+
+    uint32_t nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    float unitRandom(uint32_t& state) {
+        return static_cast<float>(nextRandom(state) >> 8) / 16777216.0f;
+    }
+
+    // Seed, level and attempt folded into one non-zero xorshift state
+    uint32_t candidateSeed(uint32_t seed, int number, int attempt) {
+        uint32_t hash = 2166136261u;
+        for (uint32_t value : { seed, static_cast<uint32_t>(number), static_cast<uint32_t>(attempt) }) {
+            hash = (hash ^ value) * 16777619u;
+            hash ^= hash >> 15;
+        }
+        return hash != 0 ? hash : 1;
+    }
+
+    // Relative density of a row; t runs from 0 at the top row to 1 at the bottom
+    float curveDensity(DensityCurve curve, int row, int rows) {
+        const float t = rows > 1 ? static_cast<float>(row) / (rows - 1) : 0.0f;
+        switch (curve) {
+            case DensityCurve::FLAT:         return 1.0f;
+            case DensityCurve::TOP_HEAVY:    return 1.2f - 0.6f * t;
+            case DensityCurve::BOTTOM_HEAVY: return 0.6f + 0.6f * t;
+            case DensityCurve::BANDS:        return row % 2 == 0 ? 1.2f : 0.35f;
+            case DensityCurve::HOURGLASS:    return 0.5f + 0.7f * std::fabs(2.0f * t - 1.0f);
+            case DensityCurve::COUNT:        break;
+        }
+        return 1.0f;
+    }
+}
+
+LevelDesign LevelGenerator::generate(uint32_t seed, int number, int attempt) {
+    uint32_t state = candidateSeed(seed, number, attempt);
+    LevelDesign level{GameMode::ENDLESS, state, number, std::vector<uint8_t>(Layout::COUNT, 0)};
+
+    const float difficulty = std::min(1.0f, static_cast<float>(number - 1) / LevelTuning::RAMP_LEVELS);
+    const float relief = std::max(0.4f, 1.0f - 0.05f * attempt);
+    const int rows = std::min(Layout::ROWS, 5 + number / 2);
+    const DensityCurve curve = static_cast<DensityCurve>(nextRandom(state) % static_cast<uint32_t>(DensityCurve::COUNT));
+
+    // Left half only; the right half mirrors it. Half the levels get an empty
+    // channel the ball can climb through.
+    const int half = (Layout::COLS + 1) / 2;
+    const int channel = nextRandom(state) % 2 == 0 ? static_cast<int>(nextRandom(state) % half) : -1;
+
+    auto set = [&](int row, int col, uint8_t hitPoints) {
+        level.hitPoints[row * Layout::COLS + col] = hitPoints;
+        level.hitPoints[row * Layout::COLS + (Layout::COLS - 1 - col)] = hitPoints;
+    };
+
+    for (int row = 0; row < rows; row++) {
+        const float density = std::min(1.0f, (0.5f + 0.4f * difficulty) * curveDensity(curve, row, rows) * relief);
+        // Tough bricks gather towards the top, where the ball spends less time
+        const float top = 1.0f - static_cast<float>(row) / rows;
+        for (int col = 0; col < half; col++) {
+            if (col == channel || unitRandom(state) >= density) {
+                continue;
+            }
+            const float toughness = unitRandom(state);
+            uint8_t hitPoints = 1;
+            if (toughness < (0.05f + 0.25f * difficulty) * top) {
+                hitPoints = 3;
+            } else if (toughness < (0.15f + 0.4f * difficulty) * top) {
+                hitPoints = 2;
+            }
+            set(row, col, hitPoints);
+        }
+    }
+
+    // Never hand out a near-empty level
+    if (level.brickCount() < LevelTuning::MIN_BRICKS) {
+        for (int col = 0; col < half; col++) {
+            set(rows / 2, col, 1);
+        }
+    }
+    return level;
+}
+
+LevelValidation::LevelValidation(const LevelDesign& level)
+    : level(level), simulation(level, LevelTuning::STEP, level.seed), bot(level.seed),
+      frameLimit(static_cast<uint32_t>(LevelTuning::TARGET_SECONDS / LevelTuning::STEP)),
+      run(0), done(false), passed(false) {
+    bot.onEvent(simulation);
+}
+
+uint32_t LevelValidation::runSeed() const {
+    return level.seed + static_cast<uint32_t>(run) * 2654435761u;
+}
+
+bool LevelValidation::advance(int maxEvents) {
+    for (int events = 0; events < maxEvents && !done; events++) {
+        if (!simulation.isOver() && simulation.getFrame() < frameLimit) {
+            simulation.fastForward(bot, frameLimit - simulation.getFrame());
+            continue;
+        }
+
+        // Run finished: one clear accepts the level
+        if (simulation.isWon()) {
+            done = true;
+            passed = true;
+            break;
+        }
+        if (++run == LevelTuning::VALIDATION_RUNS) {
+            done = true;
+            break;
+        }
+        simulation.reset(runSeed());
+        bot = TrackingBot(runSeed());
+        bot.onEvent(simulation);
+    }
+    return done;
+}
+
+LevelQueue::LevelQueue(int workerCount)
+    : stopping(false), seed(0), epoch(0), started(false), producingNumber(1), nextAttempt(0), firstUndecided(0),
+      pumpJob{}, acceptedCount(0), candidateCount(0), productionSeconds(0.0), levelStartedAt(Clock::now()) {
+    MemoryScope scope(MemoryTag::LEVELS);
+#if LEVEL_QUEUE_THREADS
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&LevelQueue::workerLoop, this);
+    }
+#else
+    (void)workerCount;
+#endif
+}
+
+LevelQueue::~LevelQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int LevelQueue::defaultWorkerCount() {
+#if LEVEL_QUEUE_THREADS
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(4, hardware - 1));
+#else
+    return 0;
+#endif
+}
+
+void LevelQueue::start(uint32_t newSeed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        seed = newSeed;
+        epoch++;
+        started = true;
+        ready.clear();
+        producingNumber = 1;
+        nextAttempt = 0;
+        firstUndecided = 0;
+        outcomes.clear();
+        candidates.clear();
+        pumpValidation.reset();
+        acceptedCount = 0;
+        candidateCount = 0;
+        productionSeconds = 0.0;
+        levelStartedAt = Clock::now();
+    }
+    workAvailable.notify_all();
+}
+
+bool LevelQueue::claimJob(Job& job) {
+    if (!started || static_cast<int>(ready.size()) >= PREFETCH ||
+        nextAttempt >= firstUndecided + MAX_ATTEMPTS_AHEAD) {
+        return false;
+    }
+    job = Job{epoch, producingNumber, nextAttempt++};
+    outcomes.resize(nextAttempt, PENDING);
+    candidates.resize(nextAttempt);
+    return true;
+}
+
+void LevelQueue::finishJob(const Job& job, LevelDesign&& design, bool passed) {
+    // Results for a level that was already accepted, or from before a restart
+    if (job.epoch != epoch || job.number != producingNumber) {
+        return;
+    }
+    outcomes[job.attempt] = passed ? ACCEPTED : REJECTED;
+    if (passed) {
+        candidates[job.attempt] = std::move(design);
+    }
+
+    while (firstUndecided < nextAttempt && outcomes[firstUndecided] == REJECTED) {
+        firstUndecided++;
+    }
+    if (firstUndecided < nextAttempt && outcomes[firstUndecided] == ACCEPTED) {
+        const Clock::time_point now = Clock::now();
+        ready.push_back(std::move(candidates[firstUndecided]));
+        acceptedCount++;
+        // The attempts a single generator would have made; speculative ones
+        // past the accepted attempt don't count, whatever the worker count
+        candidateCount += firstUndecided + 1;
+        productionSeconds += std::chrono::duration<double>(now - levelStartedAt).count();
+        levelStartedAt = now;
+
+        producingNumber++;
+        nextAttempt = 0;
+        firstUndecided = 0;
+        outcomes.clear();
+        candidates.clear();
+        levelReady.notify_all();
+    }
+    workAvailable.notify_all();
+}
+
+void LevelQueue::workerLoop() {
+    MemoryScope scope(MemoryTag::LEVELS);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        Job job{};
+        workAvailable.wait(lock, [&] { return stopping || claimJob(job); });
+        if (stopping) {
+            return;
+        }
+        const uint32_t jobSeed = seed;
+        lock.unlock();
+
+        LevelValidation validation(LevelGenerator::generate(jobSeed, job.number, job.attempt));
+        validation.advance(std::numeric_limits<int>::max());
+
+        lock.lock();
+        finishJob(job, LevelDesign(validation.getLevel()), validation.hasPassed());
+    }
+}
+
+void LevelQueue::pump(double budgetSeconds) {
+    if (!workers.empty()) {
+        return;
+    }
+    const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(budgetSeconds));
+
+    MemoryScope scope(MemoryTag::LEVELS);
+    std::lock_guard<std::mutex> lock(mutex);
+    do {
+        if (!pumpValidation) {
+            if (!claimJob(pumpJob)) {
+                return;
+            }
+            pumpValidation = std::make_unique<LevelValidation>(
+                LevelGenerator::generate(seed, pumpJob.number, pumpJob.attempt));
+        }
+        if (pumpValidation->advance(PUMP_EVENTS)) {
+            finishJob(pumpJob, LevelDesign(pumpValidation->getLevel()), pumpValidation->hasPassed());
+            pumpValidation.reset();
+        }
+    } while (Clock::now() < deadline);
+}
+
+bool LevelQueue::tryTake(LevelDesign& level) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ready.empty()) {
+            return false;
+        }
+        // A full queue paused production; the clock restarts with the free slot
+        if (static_cast<int>(ready.size()) == PREFETCH) {
+            levelStartedAt = Clock::now();
+        }
+        level = std::move(ready.front());
+        ready.pop_front();
+    }
+    workAvailable.notify_all();
+    return true;
+}
+
+LevelDesign LevelQueue::take() {
+    LevelDesign level{};
+    while (!tryTake(level)) {
+        if (workers.empty()) {
+            pump(0.01);
+        } else {
+            std::unique_lock<std::mutex> lock(mutex);
+            levelReady.wait(lock, [&] { return !ready.empty() || !started; });
+        }
+    }
+    return level;
+}
+
+LevelQueue::Stats LevelQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Stats{static_cast<int>(ready.size()), acceptedCount, candidateCount,
+                 productionSeconds > 0.0 ? acceptedCount / productionSeconds : 0.0};
+}
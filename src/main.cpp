@@ -1,5 +1,6 @@
 #include <raylib.h>
 #include "../include/game.h"
+#include "../include/persistent_storage.h"
 #include <emscripten.h>
 #include <algorithm>
 
@@ -55,7 +56,10 @@ int main() {
     SetGesturesEnabled(GESTURE_TAP | GESTURE_DRAG);
     
     // Set target FPS and enable VSync for smoother rendering
-    SetTargetFPS(60);
+    SetTargetFPS(Game::TARGET_FPS);
+    
+    // Start loading persisted files (IDBFS populates asynchronously)
+    PersistentStorage::mount();
     
     // Create game instance and store pointer for resize handling
     Game game;
@@ -0,0 +1,187 @@
+#include "../include/memory_tracker.h"
+#include <malloc.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#include <emscripten/heap.h>
+#else
+#define EMSCRIPTEN_KEEPALIVE
+#endif
+
+namespace {
+    // Keeps the block after it aligned the way operator new promises
+    struct BlockHeader {
+        size_t size;
+        MemoryTag tag;
+    };
+    constexpr size_t HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    static_assert(sizeof(BlockHeader) <= HEADER_SIZE, "block header must fit in the alignment padding");
+
+    const char* const TAG_NAMES[MEMORY_TAG_COUNT] = {
+        "mem other",
+        "mem bricks",
+        "mem paddle+ball",
+        "mem text",
+        "mem draw lists",
+        "mem targets (gpu)",
+        "mem telemetry",
+        "mem levels",
+        "mem saves",
+        "mem spectator",
+        "mem raylib+libc"
+    };
+
+    // Constant-initialized, so usable by allocations made before main
+    std::atomic<size_t> currentBytes[MEMORY_TAG_COUNT];
+    std::atomic<size_t> peakBytes[MEMORY_TAG_COUNT];
+    std::atomic<size_t> heapPeak{0};
+
+    void raisePeak(std::atomic<size_t>& peak, size_t value) {
+        size_t seen = peak.load(std::memory_order_relaxed);
+        while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void add(MemoryTag tag, size_t bytes) {
+        const int index = static_cast<int>(tag);
+        const size_t now = currentBytes[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        raisePeak(peakBytes[index], now);
+    }
+
+    void subtract(MemoryTag tag, size_t bytes) {
+        currentBytes[static_cast<int>(tag)].fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void* allocate(size_t size) {
+        void* block = std::malloc(size + HEADER_SIZE);
+        if (!block) {
+            return nullptr;
+        }
+        BlockHeader* header = static_cast<BlockHeader*>(block);
+        header->size = size;
+        header->tag = currentMemoryTag;
+        add(header->tag, size);
+        return static_cast<char*>(block) + HEADER_SIZE;
+    }
+
+    void deallocate(void* pointer) {
+        if (!pointer) {
+            return;
+        }
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(static_cast<char*>(pointer) - HEADER_SIZE);
+        subtract(header->tag, header->size);
+        std::free(header);
+    }
+
+    void* allocateOrThrow(size_t size) {
+        void* pointer = allocate(size == 0 ? 1 : size);
+        if (!pointer) {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+}
+
+// Replacements for the global allocation functions. The aligned overloads
+// keep the library's versions; they pair with their own deletes.
+void* operator new(size_t size) { return allocateOrThrow(size); }
+void* operator new[](size_t size) { return allocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size == 0 ? 1 : size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size == 0 ? 1 : size); }
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+
+MemoryTracker::Usage MemoryTracker::getUsage(MemoryTag tag) {
+    const int index = static_cast<int>(tag);
+    return Usage{currentBytes[index].load(std::memory_order_relaxed), peakBytes[index].load(std::memory_order_relaxed)};
+}
+
+const char* MemoryTracker::getName(MemoryTag tag) {
+    return TAG_NAMES[static_cast<int>(tag)];
+}
+
+size_t MemoryTracker::getHeapInUse() {
+#if defined(__EMSCRIPTEN__)
+    return static_cast<size_t>(mallinfo().uordblks);
+#elif defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+size_t MemoryTracker::getHeapSize() {
+#ifdef __EMSCRIPTEN__
+    return emscripten_get_heap_size();
+#else
+    return 0;
+#endif
+}
+
+size_t MemoryTracker::getHeapPeak() {
+    return heapPeak.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::refresh() {
+    const size_t inUse = getHeapInUse();
+    raisePeak(heapPeak, inUse);
+
+    // Everything malloc handed out that didn't come through operator new,
+    // plus the block headers
+    size_t tagged = 0;
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        if (tag != static_cast<int>(MemoryTag::RENDER_TARGETS) && tag != static_cast<int>(MemoryTag::RAYLIB)) {
+            tagged += currentBytes[tag].load(std::memory_order_relaxed);
+        }
+    }
+    const size_t untracked = inUse > tagged ? inUse - tagged : 0;
+    const int raylib = static_cast<int>(MemoryTag::RAYLIB);
+    currentBytes[raylib].store(untracked, std::memory_order_relaxed);
+    raisePeak(peakBytes[raylib], untracked);
+}
+
+void MemoryTracker::charge(MemoryTag tag, size_t bytes) {
+    add(tag, bytes);
+}
+
+void MemoryTracker::release(MemoryTag tag, size_t bytes) {
+    subtract(tag, bytes);
+}
+
+// Queries for the page (Module.ccall) and the browser console. tag is a
+// MemoryTag; getHeapBytes takes 0 for in use, 1 for peak, 2 for heap size.
+extern "C" {
+    EMSCRIPTEN_KEEPALIVE
+    int getMemoryTagCount() {
+        return MEMORY_TAG_COUNT;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    const char* getMemoryTagName(int tag) {
+        return tag >= 0 && tag < MEMORY_TAG_COUNT ? MemoryTracker::getName(static_cast<MemoryTag>(tag)) : "";
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    double getMemoryUsage(int tag, int peak) {
+        if (tag < 0 || tag >= MEMORY_TAG_COUNT) {
+            return 0.0;
+        }
+        const MemoryTracker::Usage usage = MemoryTracker::getUsage(static_cast<MemoryTag>(tag));
+        return static_cast<double>(peak ? usage.peak : usage.current);
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    double getHeapBytes(int which) {
+        switch (which) {
+            case 0: return static_cast<double>(MemoryTracker::getHeapInUse());
+            case 1: return static_cast<double>(MemoryTracker::getHeapPeak());
+            default: return static_cast<double>(MemoryTracker::getHeapSize());
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include "../include/persistent_storage.h"
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#ifdef __EMSCRIPTEN__
+namespace {
+    const char* MOUNT_POINT = "/persist";
+}
+#endif
+
+void PersistentStorage::mount() {
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+        if (Module.persistMounted) return;
+        Module.persistMounted = true;
+        Module.persistReady = false;
+        Module.persistSyncing = false;
+
+        var mountPoint = UTF8ToString($0);
+        try { FS.mkdir(mountPoint); } catch (e) {}
+        FS.mount(IDBFS, {}, mountPoint);
+
+        // Pull existing files from IndexedDB; nothing may be written until this completes
+        FS.syncfs(true, function(err) {
+            if (err) console.error('IDBFS load failed', err);
+            Module.persistReady = true;
+        });
+    }, MOUNT_POINT);
+#endif
+}
+
+bool PersistentStorage::isReady() {
+#ifdef __EMSCRIPTEN__
+    return EM_ASM_INT({ return Module.persistReady ? 1 : 0; }) != 0;
+#else
+    return true;
+#endif
+}
+
+void PersistentStorage::sync() {
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+        if (!Module.persistReady) return;
+
+        // Coalesce: a sync requested while one is in flight runs once it finishes
+        if (Module.persistSyncing) {
+            Module.persistSyncPending = true;
+            return;
+        }
+        Module.persistSyncing = true;
+        var done = function(err) {
+            if (err) console.error('IDBFS save failed', err);
+            if (Module.persistSyncPending) {
+                Module.persistSyncPending = false;
+                FS.syncfs(false, done);
+            } else {
+                Module.persistSyncing = false;
+            }
+        };
+        FS.syncfs(false, done);
+    });
+#endif
+}
+
+std::string PersistentStorage::pathFor(const char* fileName) {
+#ifdef __EMSCRIPTEN__
+    return std::string(MOUNT_POINT) + "/" + fileName;
+#else
+    return fileName;
+#endif
+}
@@ -0,0 +1,57 @@
+#include "../include/profiler.h"
+#include <cstring>
+#include <cstdio>
+
+Profiler::Profiler() : statCount(0), eventCount(0), nextEvent(0), visible(false) {}
+
+void Profiler::setStat(const char* name, const char* value) {
+    // Stats are keyed by literal pointer; the list is short so a linear scan is fine
+    for (int i = 0; i < statCount; i++) {
+        if (stats[i].name == name) {
+            snprintf(stats[i].value, TEXT_LENGTH, "%s", value);
+            return;
+        }
+    }
+    if (statCount < MAX_STATS) {
+        stats[statCount].name = name;
+        snprintf(stats[statCount].value, TEXT_LENGTH, "%s", value);
+        statCount++;
+    }
+}
+
+void Profiler::logEvent(const char* text) {
+    snprintf(events[nextEvent], TEXT_LENGTH, "[%.1fs] %s", GetTime(), text);
+    nextEvent = (nextEvent + 1) % MAX_EVENTS;
+    if (eventCount < MAX_EVENTS) eventCount++;
+}
+
+void Profiler::draw() const {
+    if (!visible) {
+        return;
+    }
+
+    const int fontSize = 10;
+    const int lineHeight = fontSize + 2;
+    const int padding = 6;
+    const int lines = statCount + eventCount + (eventCount > 0 ? 1 : 0);
+
+    DrawRectangle(0, 0, 260, padding * 2 + lines * lineHeight, ColorAlpha(BLACK, 0.75f));
+
+    int y = padding;
+    for (int i = 0; i < statCount; i++) {
+        DrawText(TextFormat("%s: %s", stats[i].name, stats[i].value), padding, y, fontSize, LIME);
+        y += lineHeight;
+    }
+
+    if (eventCount > 0) {
+        DrawText("events:", padding, y, fontSize, GRAY);
+        y += lineHeight;
+
+        // Newest event first
+        for (int i = 0; i < eventCount; i++) {
+            int index = (nextEvent - 1 - i + MAX_EVENTS) % MAX_EVENTS;
+            DrawText(events[index], padding, y, fontSize, YELLOW);
+            y += lineHeight;
+        }
+    }
+}
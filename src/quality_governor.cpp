@@ -0,0 +1,98 @@
+#include "../include/quality_governor.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    // Ordered from best to cheapest
+    const QualityGovernor::Level LEVELS[] = {
+        { 1.0f,  true,  "native + MSAA" },
+        { 1.0f,  false, "native" },
+        { 0.85f, false, "85%" },
+        { 0.7f,  false, "70%" },
+        { 0.55f, false, "55%" },
+    };
+    const int LEVEL_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+}
+
+QualityGovernor::QualityGovernor(float targetFrameTime)
+    : budget(targetFrameTime), sampleCount(0), nextSample(0), framesSinceEvaluate(0),
+      level(0), headroomStreak(0), requiredUpgradeStreak(BASE_UPGRADE_STREAK),
+      timeSinceUpgrade(FLAP_WINDOW), p95(0.0f), p95Work(0.0f) {
+    snprintf(lastDecision, sizeof(lastDecision), "start at %s", LEVELS[0].name);
+}
+
+const QualityGovernor::Level& QualityGovernor::getLevel() const {
+    return LEVELS[level];
+}
+
+void QualityGovernor::addFrame(float seconds, float workSeconds) {
+    samples[nextSample] = seconds;
+    workSamples[nextSample] = workSeconds;
+    nextSample = (nextSample + 1) % SAMPLE_WINDOW;
+    sampleCount = std::min(sampleCount + 1, SAMPLE_WINDOW);
+    framesSinceEvaluate++;
+    timeSinceUpgrade += seconds;
+}
+
+float QualityGovernor::computeP95(const float* window) const {
+    float sorted[SAMPLE_WINDOW];
+    std::copy(window, window + sampleCount, sorted);
+    int index = (sampleCount * 95) / 100;
+    std::nth_element(sorted, sorted + index, sorted + sampleCount);
+    return sorted[index];
+}
+
+bool QualityGovernor::evaluate() {
+    // Wait for a full window so a single hitch can't trigger a change
+    if (sampleCount < SAMPLE_WINDOW || framesSinceEvaluate < EVALUATE_INTERVAL) {
+        return false;
+    }
+    framesSinceEvaluate = 0;
+    p95 = computeP95(samples);
+    p95Work = computeP95(workSamples);
+
+    if (p95 > budget * DOWNGRADE_RATIO) {
+        headroomStreak = 0;
+        if (level + 1 >= LEVEL_COUNT) {
+            return false;
+        }
+
+        // Dropping right after a raise means the raise was premature:
+        // double the headroom required before trying again
+        if (timeSinceUpgrade < FLAP_WINDOW) {
+            requiredUpgradeStreak = std::min(requiredUpgradeStreak * 2, MAX_UPGRADE_STREAK);
+        }
+        setLevel(level + 1, "p95 over budget");
+        return true;
+    }
+
+    // Vsync holds the frame time at the budget, so only the work time shows
+    // whether a more expensive level would still fit
+    if (p95 < budget * UPGRADE_RATIO && p95Work < budget * HEADROOM_RATIO && level > 0) {
+        headroomStreak++;
+        if (headroomStreak >= requiredUpgradeStreak) {
+            headroomStreak = 0;
+            timeSinceUpgrade = 0.0f;
+            setLevel(level - 1, "headroom");
+            return true;
+        }
+    } else {
+        headroomStreak = 0;
+    }
+
+    // Sustained stability at full quality resets the backoff
+    if (level == 0 && timeSinceUpgrade > FLAP_WINDOW * 6) {
+        requiredUpgradeStreak = BASE_UPGRADE_STREAK;
+    }
+    return false;
+}
+
+void QualityGovernor::setLevel(int newLevel, const char* reason) {
+    snprintf(lastDecision, sizeof(lastDecision), "%s -> %s (%s, p95 %.1f/%.1fms)",
+             LEVELS[level].name, LEVELS[newLevel].name, reason, p95 * 1000.0f, p95Work * 1000.0f);
+    level = newLevel;
+
+    // Samples taken at the old level say nothing about the new one
+    sampleCount = 0;
+    nextSample = 0;
+}
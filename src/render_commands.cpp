@@ -0,0 +1,104 @@
+#include "../include/render_commands.h"
+#include "../include/memory_tracker.h"
+#include <algorithm>
+#include <cstring>
+
+void RenderCommandBuffer::clear() {
+    commands.clear();
+    strings.clear();
+    sorted = true;
+}
+
+void RenderCommandBuffer::reserve(size_t commandCount, size_t textBytes) {
+    {
+        MemoryScope scope(MemoryTag::DRAW_LISTS);
+        commands.reserve(commandCount);
+    }
+    MemoryScope scope(MemoryTag::TEXT);
+    strings.reserve(textBytes);
+}
+
+void RenderCommandBuffer::push(DrawLayer layer, DrawPrimitive primitive, float x, float y,
+                               float width, float height, Color color, uint32_t payload) {
+    uint64_t key = (static_cast<uint64_t>(layer) << 40) |
+                   (static_cast<uint64_t>(primitive) << 32) |
+                   static_cast<uint64_t>(commands.size());
+    if (!commands.empty() && key < commands.back().sortKey) {
+        sorted = false;
+    }
+    MemoryScope scope(MemoryTag::DRAW_LISTS);
+    commands.push_back(RenderCommand{key, x, y, width, height, color, payload, primitive});
+}
+
+void RenderCommandBuffer::addRectangle(DrawLayer layer, Rectangle rect, Color color) {
+    push(layer, DrawPrimitive::RECTANGLE, rect.x, rect.y, rect.width, rect.height, color, 0);
+}
+
+void RenderCommandBuffer::addCircle(DrawLayer layer, Vector2 center, float radius, Color color) {
+    push(layer, DrawPrimitive::CIRCLE, center.x, center.y, radius, 0.0f, color, 0);
+}
+
+void RenderCommandBuffer::addText(DrawLayer layer, const char* text, float x, float y, float fontSize, Color color) {
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    size_t length = std::strlen(text);
+    MemoryScope scope(MemoryTag::TEXT);
+    strings.insert(strings.end(), text, text + length + 1);
+    push(layer, DrawPrimitive::TEXT, x, y, 0.0f, fontSize, color, offset);
+}
+
+void RenderCommandBuffer::addRenderTexture(DrawLayer layer, int slot, Rectangle dest, Color tint) {
+    push(layer, DrawPrimitive::RENDER_TEXTURE, dest.x, dest.y, dest.width, dest.height, tint,
+         static_cast<uint32_t>(slot));
+}
+
+void RenderCommandBuffer::sort() {
+    // Keys are unique (they end in the recording index), so a plain sort is stable
+    if (!sorted) {
+        std::sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+            return a.sortKey < b.sortKey;
+        });
+        sorted = true;
+    }
+}
+
+void RenderCommandBuffer::submit(const Texture2D* textureSlots) const {
+    for (const RenderCommand& command : commands) {
+        switch (command.primitive) {
+            case DrawPrimitive::RENDER_TEXTURE: {
+                const Texture2D& texture = textureSlots[command.payload];
+                Rectangle source = { 0, 0, static_cast<float>(texture.width), -static_cast<float>(texture.height) };
+                Rectangle dest = { command.x, command.y, command.width, command.height };
+                DrawTexturePro(texture, source, dest, Vector2{0, 0}, 0.0f, command.color);
+                break;
+            }
+            case DrawPrimitive::RECTANGLE:
+                DrawRectangle(static_cast<int>(command.x), static_cast<int>(command.y),
+                              static_cast<int>(command.width), static_cast<int>(command.height),
+                              command.color);
+                break;
+            case DrawPrimitive::CIRCLE:
+                DrawCircle(static_cast<int>(command.x), static_cast<int>(command.y), command.width, command.color);
+                break;
+            case DrawPrimitive::TEXT:
+                DrawText(&strings[command.payload], static_cast<int>(command.x), static_cast<int>(command.y),
+                         static_cast<int>(command.height), command.color);
+                break;
+        }
+    }
+}
+
+void RenderCommandBuffer::swap(RenderCommandBuffer& other) {
+    commands.swap(other.commands);
+    strings.swap(other.strings);
+    std::swap(sorted, other.sorted);
+}
+
+int RenderCommandBuffer::getPrimitiveSwitches() const {
+    int switches = 0;
+    for (size_t i = 1; i < commands.size(); i++) {
+        if (commands[i].primitive != commands[i - 1].primitive) {
+            switches++;
+        }
+    }
+    return switches;
+}
@@ -0,0 +1,17 @@
+#include "../include/systems.h"
+
+// Kept apart from systems.cpp so the simulation systems stay free of
+// anything render related. Only records commands; see render_commands.h.
+void renderSystem(const World& world, RenderLayer layer, DrawLayer drawLayer, RenderCommandBuffer& commands) {
+    world.each<Position, Collider, Render>([&](Entity, const Position& position,
+                                               const Collider& collider, const Render& render) {
+        if (render.layer != layer) {
+            return;
+        }
+        if (collider.shape == ColliderShape::BOX) {
+            commands.addRectangle(drawLayer, boxBounds(position, collider), render.color);
+        } else {
+            commands.addCircle(drawLayer, Vector2{position.x, position.y}, collider.radius, render.color);
+        }
+    });
+}
@@ -0,0 +1,163 @@
+#include "../include/save_store.h"
+#include "../include/memory_tracker.h"
+#include "../include/persistent_storage.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    uint32_t checksum(const SaveData& data) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&data);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < sizeof(SaveData); i++) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    SaveData defaultData() {
+        SaveData data;
+        std::memset(&data, 0, sizeof(data));
+        data.mode = static_cast<uint8_t>(GameMode::CLASSIC);
+        return data;
+    }
+}
+
+SaveStore::SaveStore(const char* fileName)
+    : data(defaultData()), loaded(false), ignoredFile(false), dirty(false), changedSettings(0), writes(0),
+      failedWrites(0) {
+    MemoryScope scope(MemoryTag::SAVES);
+    path = PersistentStorage::pathFor(fileName);
+    temporaryPath = path + ".tmp";
+}
+
+bool SaveStore::poll() {
+    if (loaded || !PersistentStorage::isReady()) {
+        return false;
+    }
+    loaded = true;
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return true;  // first run
+    }
+
+    char magic[4];
+    uint16_t version = 0;
+    uint16_t size = 0;
+    SaveData loadedData;
+    uint32_t storedChecksum = 0;
+    const bool valid = fread(magic, 1, 4, file) == 4 && memcmp(magic, "BKSV", 4) == 0 &&
+                       fread(&version, sizeof(version), 1, file) == 1 && version == FORMAT_VERSION &&
+                       fread(&size, sizeof(size), 1, file) == 1 && size == sizeof(SaveData) &&
+                       fread(&loadedData, sizeof(loadedData), 1, file) == 1 &&
+                       fread(&storedChecksum, sizeof(storedChecksum), 1, file) == 1 &&
+                       storedChecksum == checksum(loadedData);
+    fclose(file);
+
+    if (valid) {
+        merge(loadedData);
+    } else {
+        ignoredFile = true;
+    }
+    return true;
+}
+
+// Games finished before the load are kept; settings come from the file
+// unless they were changed before it
+void SaveStore::merge(const SaveData& loadedData) {
+    const SaveData played = data;
+    data = loadedData;
+    for (int mode = 0; mode < GAME_MODE_COUNT; mode++) {
+        for (int32_t score : played.topScores[mode]) {
+            insertScore(data.topScores[mode], score);
+        }
+    }
+    data.bestLevel = played.bestLevel > data.bestLevel ? played.bestLevel : data.bestLevel;
+    data.gamesPlayed += played.gamesPlayed;
+    if (changedSettings & SETTING_MODE) {
+        data.mode = played.mode;
+    }
+    if (changedSettings & SETTING_PROFILER) {
+        data.profilerVisible = played.profilerVisible;
+    }
+    if (data.mode >= GAME_MODE_COUNT) {
+        data.mode = static_cast<uint8_t>(GameMode::CLASSIC);
+    }
+}
+
+void SaveStore::insertScore(int32_t (&scores)[SaveData::TOP_SCORES], int32_t score) {
+    if (score <= scores[SaveData::TOP_SCORES - 1]) {
+        return;
+    }
+    int i = SaveData::TOP_SCORES - 1;
+    for (; i > 0 && scores[i - 1] < score; i--) {
+        scores[i] = scores[i - 1];
+    }
+    scores[i] = score;
+}
+
+bool SaveStore::recordGame(GameMode mode, int score, int level) {
+    int32_t (&scores)[SaveData::TOP_SCORES] = data.topScores[static_cast<int>(mode)];
+    const bool ranked = score > scores[SaveData::TOP_SCORES - 1];
+    insertScore(scores, score);
+    if (level > data.bestLevel) {
+        data.bestLevel = level;
+    }
+    data.gamesPlayed++;
+    dirty = true;
+    return ranked;
+}
+
+void SaveStore::setMode(GameMode mode) {
+    if (data.mode != static_cast<uint8_t>(mode)) {
+        data.mode = static_cast<uint8_t>(mode);
+        changedSettings |= SETTING_MODE;
+        dirty = true;
+    }
+}
+
+void SaveStore::setProfilerVisible(bool visible) {
+    if (data.profilerVisible != (visible ? 1 : 0)) {
+        data.profilerVisible = visible ? 1 : 0;
+        changedSettings |= SETTING_PROFILER;
+        dirty = true;
+    }
+}
+
+void SaveStore::flush() {
+    // Until the file is loaded a write would clobber it
+    if (!hasPendingWrite()) {
+        return;
+    }
+
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+    const uint16_t version = FORMAT_VERSION;
+    const uint16_t size = sizeof(SaveData);
+    const uint32_t sum = checksum(data);
+    bool written = fwrite("BKSV", 1, 4, file) == 4 &&
+                   fwrite(&version, sizeof(version), 1, file) == 1 &&
+                   fwrite(&size, sizeof(size), 1, file) == 1 &&
+                   fwrite(&data, sizeof(data), 1, file) == 1 &&
+                   fwrite(&sum, sizeof(sum), 1, file) == 1;
+    // fclose flushes the buffered bytes, so a full disk often only shows here
+    written = fclose(file) == 0 && written;
+
+    // Rename is atomic, so an interrupted save leaves the previous file
+    // intact; a short write is dropped rather than renamed over it and stays
+    // pending for the next idle tick
+    if (!written) {
+        remove(temporaryPath.c_str());
+        failedWrites++;
+        return;
+    }
+    if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        return;
+    }
+    dirty = false;
+    writes++;
+    PersistentStorage::sync();
+}
@@ -0,0 +1,455 @@
+#include "../include/simulation.h"
+#include "../include/brick_field.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Event search pads the ball by this much so float rounding in the
+    // narrow phase can never produce a contact the search didn't predict.
+    // Overestimating only costs an extra stepped frame.
+    constexpr float CONTACT_MARGIN = 0.5f;
+
+    // Broadphase categories
+    enum BodyCategory : unsigned int {
+        BODY_BALL = 1u << 0,
+        BODY_PADDLE = 1u << 1,
+        BODY_BRICK = 1u << 2
+    };
+
+    // How far ahead predictPaddleLineFrame looks (about 4.5 hours at 60 Hz)
+    constexpr uint32_t MAX_LOOKAHEAD = 1u << 20;
+
+    // First frame in [lo, hi] where a predicate that flips from false to true
+    // at most once holds; hi + 1 if it never does
+    template <typename Predicate>
+    uint32_t firstFrameWhere(uint32_t lo, uint32_t hi, Predicate reached) {
+        uint32_t end = hi + 1;
+        while (lo < end) {
+            uint32_t mid = lo + (end - lo) / 2;
+            if (reached(mid)) {
+                end = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void hashValue(uint64_t& hash, const T& value) {
+        hashBytes(hash, &value, sizeof(value));
+    }
+}
+
+Simulation::Simulation(GameMode mode, float stepSeconds, uint32_t seed)
+    : Simulation(LevelDesign{mode, 0, 0, {}}, stepSeconds, seed) {}
+
+Simulation::Simulation(const LevelDesign& level, float stepSeconds, uint32_t seed)
+    : mode(level.mode), level(level), stepSeconds(stepSeconds), playfield{800.0f, 600.0f, 1.0f, 1.0f}, tuning{},
+      paddle(NULL_ENTITY), ball(NULL_ENTITY), ballBody(-1), paddleBody(-1), segment{}, paddleAxis(0.0f),
+      frame(0), lastSpeedUpFrame(0), rngState(1), score(0), lives(INITIAL_LIVES), bricksLeft(0) {
+    reset(seed);
+}
+
+template <typename Config>
+void Simulation::setup() {
+    tuning.paddleSpeed = Config::PADDLE_BASE_SPEED;
+    tuning.ballSpeed = Config::BALL_BASE_SPEED;
+    tuning.speedIncrement = Config::BALL_SPEED_INCREMENT;
+    tuning.maxSpeed = Config::MAX_BALL_SPEED;
+    tuning.speedUpFrames = static_cast<uint32_t>(std::lround(Config::SPEED_INCREASE_INTERVAL / stepSeconds));
+
+    if (level.hitPoints.empty()) {
+        BrickField<Config>::spawn(world, playfield.width, playfield.height);
+        bricksLeft = BrickField<Config>::COUNT;
+    } else {
+        BrickField<Config>::spawn(world, playfield.width, playfield.height, level);
+        bricksLeft = level.brickCount();
+    }
+}
+
+void Simulation::reset(uint32_t seed) {
+    world.clear();
+    broadphase.clear();
+    frame = 0;
+    score = 0;
+    lives = INITIAL_LIVES;
+    rngState = seed != 0 ? seed : 1;  // xorshift can't leave zero
+
+    switch (mode) {
+        case GameMode::CLASSIC:   setup<ClassicConfig>(); break;
+        case GameMode::MEGA_GRID: setup<MegaGridConfig>(); break;
+        case GameMode::CHAOS:     setup<ChaosConfig>(); break;
+        case GameMode::ENDLESS:   setup<EndlessConfig>(); break;
+    }
+
+    world.each<Position, Collider, Health>([this](Entity entity, Position& position, Collider& collider, Health&) {
+        collider.broadphaseHandle = broadphase.add(boxBounds(position, collider), BODY_BRICK, BODY_BALL,
+                                                   static_cast<int>(entity.index));
+    });
+    paddleBody = broadphase.add(Rectangle{}, BODY_PADDLE, BODY_BALL, 0);
+    ballBody = broadphase.add(Rectangle{}, BODY_BALL, BODY_BRICK | BODY_PADDLE, 0);
+
+    serve();
+}
+
+void Simulation::serve() {
+    world.destroy(paddle);
+    world.destroy(ball);
+    paddle = spawnPaddle(world, playfield, tuning.paddleSpeed);
+    ball = spawnBall(world, playfield, tuning.ballSpeed);
+    resizeSystem(world, playfield);
+
+    paddleAxis = 0.0f;
+    lastSpeedUpFrame = frame;
+    rebase();
+}
+
+void Simulation::rebase() {
+    const Position& position = world.get<Position>(ball);
+    const Velocity& velocity = world.get<Velocity>(ball);
+    segment = BallSegment{frame, position.x, position.y, velocity.dirX, velocity.dirY, velocity.speed, velocity.spin};
+}
+
+// Spin decays linearly to zero, one decrement per frame after it is used
+float Simulation::spinAfter(uint32_t frames) const {
+    const float decay = BallTuning::SPIN_DECAY * stepSeconds;
+    if (segment.spin > 0.0f) {
+        return std::max(0.0f, segment.spin - frames * decay);
+    }
+    if (segment.spin < 0.0f) {
+        return std::min(0.0f, segment.spin + frames * decay);
+    }
+    return 0.0f;
+}
+
+// Sum of the spin used by the first `frames` frames, as an arithmetic series
+float Simulation::spinSumAfter(uint32_t frames) const {
+    if (segment.spin == 0.0f) {
+        return 0.0f;
+    }
+    const float decay = BallTuning::SPIN_DECAY * stepSeconds;
+    const float magnitude = std::fabs(segment.spin);
+    const uint64_t spinning = std::min<uint64_t>(frames, static_cast<uint64_t>(std::ceil(magnitude / decay)));
+    const uint64_t triangle = spinning * (spinning - (spinning > 0 ? 1 : 0)) / 2;
+    const float sum = spinning * magnitude - decay * static_cast<float>(triangle);
+    return segment.spin > 0.0f ? sum : -sum;
+}
+
+Vector2 Simulation::segmentPosition(uint32_t frames) const {
+    const float stepX = segment.dirX * segment.speed * playfield.widthScale * stepSeconds;
+    const float stepY = segment.dirY * segment.speed * playfield.heightScale * stepSeconds;
+    const float distance = static_cast<float>(frames) + BallTuning::SPIN_INFLUENCE * spinSumAfter(frames);
+    return Vector2{segment.x + stepX * distance, segment.y + stepY * static_cast<float>(frames)};
+}
+
+Vector2 Simulation::ballPositionAt(uint32_t atFrame) const {
+    return segmentPosition(atFrame - segment.frame);
+}
+
+Velocity Simulation::getBallVelocity() const {
+    return Velocity{segment.dirX, segment.dirY, segment.speed, spinAfter(frame - segment.frame)};
+}
+
+float Simulation::getBallRadius() const {
+    return world.get<Collider>(ball).radius;
+}
+
+Rectangle Simulation::getPaddleRect() const {
+    return boxBounds(world.get<Position>(paddle), world.get<Collider>(paddle));
+}
+
+uint32_t Simulation::predictPaddleLineFrame() const {
+    if (segment.dirY <= 0.0f) {
+        return UINT32_MAX;
+    }
+    const float radius = getBallRadius();
+    const float paddleTop = getPaddleRect().y;
+    uint32_t reached = firstFrameWhere(frame + 1, frame + MAX_LOOKAHEAD, [&](uint32_t f) {
+        return ballPositionAt(f).y + radius >= paddleTop;
+    });
+    return reached > frame + MAX_LOOKAHEAD ? UINT32_MAX : reached;
+}
+
+uint32_t Simulation::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+void Simulation::movePaddle(PaddleController& controller) {
+    // Same arithmetic as paddleInputSystem + movementSystem + containmentSystem
+    Position& position = world.get<Position>(paddle);
+    const Collider& collider = world.get<Collider>(paddle);
+    paddleAxis = controller.axis(frame, position.x);
+    position.x += paddleAxis * tuning.paddleSpeed * playfield.widthScale * stepSeconds;
+    position.x = std::max(0.0f, std::min(position.x, playfield.width - collider.width));
+}
+
+uint32_t Simulation::step(PaddleController& controller) {
+    if (isOver()) {
+        return 0;
+    }
+    frame++;
+    movePaddle(controller);
+    uint32_t events = resolveFrame();
+    if (events != 0) {
+        controller.onEvent(*this);
+    }
+    return events;
+}
+
+// Mirrors the order of Game::updatePlaying
+uint32_t Simulation::resolveFrame() {
+    Position& position = world.get<Position>(ball);
+    Velocity& velocity = world.get<Velocity>(ball);
+    const Collider& collider = world.get<Collider>(ball);
+
+    const uint32_t elapsed = frame - segment.frame;
+    const Vector2 moved = segmentPosition(elapsed);
+    position = Position{moved.x, moved.y};
+    velocity = Velocity{segment.dirX, segment.dirY, segment.speed, spinAfter(elapsed)};
+
+    uint32_t events = 0;
+    if (bounceOffWalls(position, velocity, collider, playfield)) {
+        events |= SIM_EVENT_WALL;
+    }
+
+    if (frame - lastSpeedUpFrame >= tuning.speedUpFrames) {
+        increaseSpeed(velocity, tuning.speedIncrement, tuning.maxSpeed);
+        lastSpeedUpFrame = frame;
+        events |= SIM_EVENT_SPEED_UP;
+    }
+
+    const Rectangle paddleRect = getPaddleRect();
+    broadphase.update(ballBody, circleBounds(position, collider));
+    broadphase.update(paddleBody, paddleRect);
+
+    bool paddleCandidate = false;
+    brickCandidates.clear();
+    for (const SweepAndPrune::Pair& pair : broadphase.findPairs()) {
+        if (pair.a != ballBody && pair.b != ballBody) {
+            continue;
+        }
+        int other = pair.a == ballBody ? pair.b : pair.a;
+        if (other == paddleBody) {
+            paddleCandidate = true;
+        } else {
+            brickCandidates.push_back(world.entityAt(static_cast<uint32_t>(broadphase.getUserData(other))));
+        }
+    }
+
+    float hitOffset = 0.0f;
+    if (paddleCandidate && resolveBallPaddle(position, velocity, collider, paddleRect, paddleAxis, hitOffset)) {
+        events |= SIM_EVENT_PADDLE;
+    }
+
+    std::sort(brickCandidates.begin(), brickCandidates.end(), [this](Entity a, Entity b) {
+        return world.get<GridCell>(a).index < world.get<GridCell>(b).index;
+    });
+    for (Entity brick : brickCandidates) {
+        Rectangle brickRect = boxBounds(world.get<Position>(brick), world.get<Collider>(brick));
+        // Random numbers are only drawn for real contacts, so both advance
+        // modes consume the same sequence
+        if (!circleOverlapsRect(Vector2{position.x, position.y}, collider.radius, brickRect) ||
+            !resolveBallBrick(position, velocity, collider, brickRect, nextRandom())) {
+            continue;
+        }
+        Health& health = world.get<Health>(brick);
+        if (--health.hitPoints <= 0) {
+            score += health.scoreValue;
+            // Removed, not disabled: the entity index stored as user data gets reused
+            broadphase.remove(world.get<Collider>(brick).broadphaseHandle);
+            world.destroy(brick);
+            bricksLeft--;
+        }
+        events |= SIM_EVENT_BRICK;
+        break;
+    }
+
+    if (position.y + collider.radius > playfield.height) {
+        lives--;
+        if (lives > 0) {
+            serve();
+        }
+        return events | SIM_EVENT_LIFE_LOST;
+    }
+
+    if (bounceOffWalls(position, velocity, collider, playfield)) {
+        events |= SIM_EVENT_WALL;
+    }
+    if (events != 0) {
+        rebase();
+    }
+    return events;
+}
+
+// Earliest frame in (frame, limit] on which resolveFrame could do anything.
+// Along one segment the ball's x and y are each monotonic, so "has the ball
+// reached this line yet" flips once and can be binary searched.
+uint32_t Simulation::nextEventFrame(uint32_t limit) const {
+    const uint32_t first = frame + 1;
+    if (first >= limit) {
+        return limit;
+    }
+
+    const float radius = getBallRadius() + CONTACT_MARGIN;
+    uint32_t best = std::min(limit, lastSpeedUpFrame + tuning.speedUpFrames);
+
+    // Walls ahead of the ball, and the paddle's top edge if falling
+    if (segment.dirX < 0.0f) {
+        best = std::min(best, firstFrameWhere(first, best, [&](uint32_t f) { return ballPositionAt(f).x - radius < 0; }));
+    } else if (segment.dirX > 0.0f) {
+        best = std::min(best, firstFrameWhere(first, best, [&](uint32_t f) {
+            return ballPositionAt(f).x + radius > playfield.width;
+        }));
+    }
+    if (segment.dirY < 0.0f) {
+        best = std::min(best, firstFrameWhere(first, best, [&](uint32_t f) { return ballPositionAt(f).y - radius < 0; }));
+    } else if (segment.dirY > 0.0f) {
+        const float paddleTop = getPaddleRect().y;
+        best = std::min(best, firstFrameWhere(first, best, [&](uint32_t f) {
+            return ballPositionAt(f).y + radius >= paddleTop;
+        }));
+    }
+    if (best <= first) {
+        return first;
+    }
+
+    // Bricks: only ones inside the box the ball sweeps before `best` can be
+    // hit first. For those, the frames where the padded ball overlaps the
+    // brick on each axis form an interval; the brick's first possible
+    // contact is where the two intervals start to overlap.
+    const Vector2 from = ballPositionAt(first);
+    const Vector2 to = ballPositionAt(best);
+    const Rectangle swept = { std::min(from.x, to.x) - radius, std::min(from.y, to.y) - radius,
+                              std::fabs(to.x - from.x) + 2 * radius, std::fabs(to.y - from.y) + 2 * radius };
+
+    auto axisInterval = [&](float direction, float low, float high, uint32_t searchEnd, auto coordinate,
+                            uint32_t& enter, uint32_t& exit) {
+        if (direction > 0.0f) {
+            enter = firstFrameWhere(first, searchEnd, [&](uint32_t f) { return coordinate(f) + radius >= low; });
+            exit = firstFrameWhere(enter, searchEnd, [&](uint32_t f) { return coordinate(f) - radius > high; });
+        } else if (direction < 0.0f) {
+            enter = firstFrameWhere(first, searchEnd, [&](uint32_t f) { return coordinate(f) - radius <= high; });
+            exit = firstFrameWhere(enter, searchEnd, [&](uint32_t f) { return coordinate(f) + radius < low; });
+        } else {
+            float value = coordinate(first);
+            bool inside = value + radius >= low && value - radius <= high;
+            enter = inside ? first : searchEnd + 1;
+            exit = searchEnd + 1;
+        }
+    };
+    auto xAt = [this](uint32_t f) { return ballPositionAt(f).x; };
+    auto yAt = [this](uint32_t f) { return ballPositionAt(f).y; };
+
+    world.each<Position, Collider, Health>([&](Entity, const Position& position, const Collider& collider,
+                                               const Health&) {
+        const Rectangle brick = boxBounds(position, collider);
+        if (brick.x > swept.x + swept.width || brick.x + brick.width < swept.x ||
+            brick.y > swept.y + swept.height || brick.y + brick.height < swept.y) {
+            return;
+        }
+        uint32_t enterX, exitX, enterY, exitY;
+        axisInterval(segment.dirX, brick.x, brick.x + brick.width, best, xAt, enterX, exitX);
+        if (enterX >= best) {
+            return;
+        }
+        axisInterval(segment.dirY, brick.y, brick.y + brick.height, best, yAt, enterY, exitY);
+        uint32_t enter = std::max(enterX, enterY);
+        if (enter < std::min(exitX, exitY) && enter < best) {
+            best = enter;
+        }
+    });
+
+    return std::max(best, first);
+}
+
+uint32_t Simulation::fastForward(PaddleController& controller, uint32_t maxFrames) {
+    const uint32_t limit = frame + maxFrames;
+    while (!isOver() && frame < limit) {
+        const uint32_t target = nextEventFrame(limit);
+        // Only the paddle changes on the frames before target
+        while (frame + 1 < target) {
+            frame++;
+            movePaddle(controller);
+        }
+        uint32_t events = step(controller);
+        if (events != 0) {
+            return events;
+        }
+    }
+    return 0;
+}
+
+uint64_t Simulation::stateHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    hashValue(hash, frame);
+    hashValue(hash, score);
+    hashValue(hash, lives);
+    hashValue(hash, bricksLeft);
+
+    const Vector2 ballPosition = getBallPosition();
+    const Velocity velocity = getBallVelocity();
+    hashValue(hash, ballPosition.x);
+    hashValue(hash, ballPosition.y);
+    hashValue(hash, velocity.dirX);
+    hashValue(hash, velocity.dirY);
+    hashValue(hash, velocity.speed);
+    hashValue(hash, velocity.spin);
+    hashValue(hash, world.get<Position>(paddle).x);
+
+    // Surviving bricks as a bitmap over grid cells, independent of storage order
+    uint64_t alive[16] = {};
+    world.each<GridCell>([&](Entity, const GridCell& cell) {
+        alive[(cell.index / 64) % 16] |= 1ull << (cell.index % 64);
+    });
+    hashBytes(hash, alive, sizeof(alive));
+    return hash;
+}
+
+TrackingBot::TrackingBot(uint32_t seed) : rng(seed != 0 ? seed : 1), target(400.0f), paddleWidth(100.0f) {}
+
+void TrackingBot::onEvent(const Simulation& simulation) {
+    paddleWidth = simulation.getPaddleRect().width;
+    uint32_t arrival = simulation.predictPaddleLineFrame();
+    if (arrival == UINT32_MAX) {
+        return;
+    }
+
+    // Fold the straight-line prediction back between the side walls
+    const float width = simulation.getPlayfield().width;
+    float x = std::fmod(simulation.ballPositionAt(arrival).x, 2.0f * width);
+    if (x < 0.0f) {
+        x += 2.0f * width;
+    }
+    if (x > width) {
+        x = 2.0f * width - x;
+    }
+
+    float offset = (static_cast<float>(next() % 1000) / 1000.0f - 0.5f) * paddleWidth * 0.8f;
+    target = x - offset;
+}
+
+float TrackingBot::axis(uint32_t, float paddleX) {
+    float difference = target - (paddleX + paddleWidth / 2);
+    if (difference > DEAD_ZONE) return 1.0f;
+    if (difference < -DEAD_ZONE) return -1.0f;
+    return 0.0f;
+}
+
+uint32_t TrackingBot::next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
@@ -0,0 +1,347 @@
+#include "../include/software_raster.h"
+#include "../include/brick_field.h"
+#include "../include/systems.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// Spans are processed 16 pixels at a time with GCC/Clang vector extensions,
+// which compile to SSE2 or AVX2 natively, NEON on ARM and simd128 under
+// Emscripten with -msimd128. Other compilers take the scalar path.
+#if defined(__GNUC__) || defined(__clang__)
+#define SOFTWARE_RASTER_VECTORS 1
+#endif
+
+namespace {
+#ifdef SOFTWARE_RASTER_VECTORS
+    typedef uint8_t Bytes16 __attribute__((vector_size(16)));
+    typedef uint16_t Words16 __attribute__((vector_size(32)));
+#endif
+
+    constexpr int EDGE_SAMPLES = 8;  // per axis, for pixels on a circle's edge
+
+    uint8_t luminance(Color color) {
+        return static_cast<uint8_t>((77 * color.r + 150 * color.g + 29 * color.b + 128) >> 8);
+    }
+
+    int toAlpha(float coverage) {
+        return static_cast<int>(coverage * 256.0f + 0.5f);
+    }
+
+    template <typename Config>
+    Color cellColor(int index) {
+        return BrickLayout<Config>::CELLS[index].color;
+    }
+
+    Color brickColor(GameMode mode, int index) {
+        switch (mode) {
+            case GameMode::CLASSIC:   return cellColor<ClassicConfig>(index);
+            case GameMode::MEGA_GRID: return cellColor<MegaGridConfig>(index);
+            case GameMode::CHAOS:     return cellColor<ChaosConfig>(index);
+            case GameMode::ENDLESS:   return cellColor<EndlessConfig>(index);
+        }
+        return WHITE;
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, Format format, float sourceWidth, float sourceHeight)
+    : width(width), height(height), channels(static_cast<int>(format)),
+      scaleX(width / sourceWidth), scaleY(height / sourceHeight) {}
+
+void SoftwareRasterizer::setSourceSize(float sourceWidth, float sourceHeight) {
+    scaleX = width / sourceWidth;
+    scaleY = height / sourceHeight;
+    brickLayer.clear();
+}
+
+SoftwareRasterizer::Pattern SoftwareRasterizer::makePattern(Color color) const {
+    Pattern pattern;
+    if (channels == 1) {
+        std::memset(pattern.bytes, luminance(color), sizeof(pattern.bytes));
+    } else {
+        for (int i = 0; i < 16; i++) {
+            pattern.bytes[i * 3] = color.r;
+            pattern.bytes[i * 3 + 1] = color.g;
+            pattern.bytes[i * 3 + 2] = color.b;
+        }
+    }
+    return pattern;
+}
+
+void SoftwareRasterizer::blendPixel(uint8_t* row, int column, const Pattern& pattern, int alpha, Blend blend) const {
+    uint8_t* pixel = row + column * channels;
+    for (int c = 0; c < channels; c++) {
+        if (blend == Blend::ADD) {
+            pixel[c] = static_cast<uint8_t>(std::min(255, pixel[c] + ((pattern.bytes[c] * alpha + 128) >> 8)));
+        } else {
+            pixel[c] = static_cast<uint8_t>((pixel[c] * (256 - alpha) + pattern.bytes[c] * alpha + 128) >> 8);
+        }
+    }
+}
+
+void SoftwareRasterizer::blendSpan(uint8_t* row, int first, int count, const Pattern& pattern, int alpha,
+                                   Blend blend) const {
+    if (count <= 0 || alpha <= 0) {
+        return;
+    }
+    uint8_t* out = row + first * channels;
+    const int bytes = count * channels;
+    const int chunk = 16 * channels;  // whole pixels, so the pattern lines up
+    int done = 0;
+
+#ifdef SOFTWARE_RASTER_VECTORS
+    if (alpha >= 256 && blend == Blend::OVER) {
+        for (; done + chunk <= bytes; done += chunk) {
+            std::memcpy(out + done, pattern.bytes, chunk);
+        }
+    } else if (blend == Blend::ADD) {
+        const Words16 round = Words16{} + static_cast<uint16_t>(128);
+        const Words16 limit = Words16{} + static_cast<uint16_t>(255);
+        Words16 source[3];
+        for (int v = 0; v < channels; v++) {
+            Bytes16 lane;
+            std::memcpy(&lane, pattern.bytes + v * 16, 16);
+            source[v] = (__builtin_convertvector(lane, Words16) * static_cast<uint16_t>(alpha) + round) >> 8;
+        }
+        for (; done + chunk <= bytes; done += chunk) {
+            for (int v = 0; v < channels; v++) {
+                Bytes16 lane;
+                std::memcpy(&lane, out + done + v * 16, 16);
+                const Words16 sum = __builtin_convertvector(lane, Words16) + source[v];
+                lane = __builtin_convertvector(sum > limit ? limit : sum, Bytes16);
+                std::memcpy(out + done + v * 16, &lane, 16);
+            }
+        }
+    } else {
+        const Words16 inverse = Words16{} + static_cast<uint16_t>(256 - alpha);
+        const Words16 round = Words16{} + static_cast<uint16_t>(128);
+        Words16 source[3];
+        for (int v = 0; v < channels; v++) {
+            Bytes16 lane;
+            std::memcpy(&lane, pattern.bytes + v * 16, 16);
+            source[v] = __builtin_convertvector(lane, Words16) * static_cast<uint16_t>(alpha) + round;
+        }
+        for (; done + chunk <= bytes; done += chunk) {
+            for (int v = 0; v < channels; v++) {
+                Bytes16 lane;
+                std::memcpy(&lane, out + done + v * 16, 16);
+                const Words16 mixed = (__builtin_convertvector(lane, Words16) * inverse + source[v]) >> 8;
+                lane = __builtin_convertvector(mixed, Bytes16);
+                std::memcpy(out + done + v * 16, &lane, 16);
+            }
+        }
+    }
+#endif
+
+    if (blend == Blend::ADD) {
+        for (; done < bytes; done++) {
+            out[done] = static_cast<uint8_t>(std::min(255, out[done] + ((pattern.bytes[done % chunk] * alpha + 128) >> 8)));
+        }
+    } else if (alpha >= 256) {
+        for (; done < bytes; done++) {
+            out[done] = pattern.bytes[done % chunk];
+        }
+    } else {
+        for (; done < bytes; done++) {
+            out[done] = static_cast<uint8_t>((out[done] * (256 - alpha) + pattern.bytes[done % chunk] * alpha + 128) >> 8);
+        }
+    }
+}
+
+void SoftwareRasterizer::clear(uint8_t* pixels, Color color) const {
+    const Pattern pattern = makePattern(color);
+    for (int y = 0; y < height; y++) {
+        blendSpan(pixels + static_cast<size_t>(y) * width * channels, 0, width, pattern, 256, Blend::OVER);
+    }
+}
+
+void SoftwareRasterizer::fillRect(uint8_t* pixels, Rectangle rect, Color color) const {
+    drawRect(pixels, rect, color, Blend::OVER);
+}
+
+void SoftwareRasterizer::addRect(uint8_t* pixels, Rectangle rect, Color color) const {
+    drawRect(pixels, rect, color, Blend::ADD);
+}
+
+// Coverage separates into row times column fractions, so only the border
+// pixels blend and every row's interior is one span
+void SoftwareRasterizer::drawRect(uint8_t* pixels, Rectangle rect, Color color, Blend blend) const {
+    const float x0 = std::max(0.0f, rect.x * scaleX);
+    const float x1 = std::min(static_cast<float>(width), (rect.x + rect.width) * scaleX);
+    const float y0 = std::max(0.0f, rect.y * scaleY);
+    const float y1 = std::min(static_cast<float>(height), (rect.y + rect.height) * scaleY);
+    if (x1 <= x0 || y1 <= y0) {
+        return;
+    }
+
+    const Pattern pattern = makePattern(color);
+    const int left = static_cast<int>(x0);
+    const int right = static_cast<int>(std::ceil(x1)) - 1;
+    const float leftCoverage = left == right ? x1 - x0 : left + 1 - x0;
+    const float rightCoverage = x1 - right;
+
+    for (int y = static_cast<int>(y0); y < static_cast<int>(std::ceil(y1)); y++) {
+        const float rowCoverage = std::min(y1, y + 1.0f) - std::max(y0, static_cast<float>(y));
+        uint8_t* row = pixels + static_cast<size_t>(y) * width * channels;
+        blendPixel(row, left, pattern, toAlpha(leftCoverage * rowCoverage), blend);
+        if (right > left) {
+            blendSpan(row, left + 1, right - left - 1, pattern, toAlpha(rowCoverage), blend);
+            blendPixel(row, right, pattern, toAlpha(rightCoverage * rowCoverage), blend);
+        }
+    }
+}
+
+// The target may scale x and y differently, so this is really an ellipse.
+// Per row, columns inside the ellipse at the row's farther edge are fully
+// covered; between that and the extent at the nearer edge, pixels are
+// supersampled.
+void SoftwareRasterizer::fillCircle(uint8_t* pixels, Vector2 center, float radius, Color color) const {
+    const float cx = center.x * scaleX;
+    const float cy = center.y * scaleY;
+    const float rx = radius * scaleX;
+    const float ry = radius * scaleY;
+    if (rx <= 0.0f || ry <= 0.0f) {
+        return;
+    }
+
+    const Pattern pattern = makePattern(color);
+    const int top = std::max(0, static_cast<int>(std::floor(cy - ry)));
+    const int bottom = std::min(height - 1, static_cast<int>(std::ceil(cy + ry)) - 1);
+    const float step = 1.0f / EDGE_SAMPLES;
+
+    for (int y = top; y <= bottom; y++) {
+        const float nearY = (cy >= y && cy <= y + 1.0f) ? 0.0f : std::min(std::fabs(y - cy), std::fabs(y + 1.0f - cy));
+        const float farY = std::max(std::fabs(y - cy), std::fabs(y + 1.0f - cy));
+        const float nearT = nearY / ry;
+        if (nearT >= 1.0f) {
+            continue;
+        }
+        const float outer = rx * std::sqrt(1.0f - nearT * nearT);
+        const int first = std::max(0, static_cast<int>(std::floor(cx - outer)));
+        const int last = std::min(width - 1, static_cast<int>(std::ceil(cx + outer)) - 1);
+
+        int innerFirst = last + 1;
+        int innerEnd = last + 1;
+        const float farT = farY / ry;
+        if (farT < 1.0f) {
+            const float inner = rx * std::sqrt(1.0f - farT * farT);
+            innerFirst = std::max(first, static_cast<int>(std::ceil(cx - inner)));
+            innerEnd = std::min(last + 1, static_cast<int>(std::floor(cx + inner)));
+            if (innerEnd <= innerFirst) {
+                innerFirst = innerEnd = last + 1;
+            }
+        }
+
+        uint8_t* row = pixels + static_cast<size_t>(y) * width * channels;
+        for (int x = first; x <= last; x++) {
+            if (x == innerFirst) {
+                blendSpan(row, innerFirst, innerEnd - innerFirst, pattern, 256, Blend::OVER);
+                x = innerEnd - 1;
+                continue;
+            }
+            int hits = 0;
+            for (int sy = 0; sy < EDGE_SAMPLES; sy++) {
+                const float dy = (y + (sy + 0.5f) * step - cy) / ry;
+                for (int sx = 0; sx < EDGE_SAMPLES; sx++) {
+                    const float dx = (x + (sx + 0.5f) * step - cx) / rx;
+                    hits += dx * dx + dy * dy <= 1.0f ? 1 : 0;
+                }
+            }
+            blendPixel(row, x, pattern, hits * 256 / (EDGE_SAMPLES * EDGE_SAMPLES), Blend::OVER);
+        }
+    }
+}
+
+void SoftwareRasterizer::renderWorld(const World& world, uint8_t* pixels) const {
+    clear(pixels, BLACK);
+    for (RenderLayer layer : { RenderLayer::BRICKS, RenderLayer::DYNAMIC }) {
+        world.each<Position, Collider, Render>([&](Entity, const Position& position,
+                                                   const Collider& collider, const Render& render) {
+            if (render.layer != layer) {
+                return;
+            }
+            if (collider.shape == ColliderShape::BOX) {
+                drawRect(pixels, boxBounds(position, collider), render.color,
+                         layer == RenderLayer::BRICKS ? Blend::ADD : Blend::OVER);
+            } else {
+                fillCircle(pixels, Vector2{position.x, position.y}, collider.radius, render.color);
+            }
+        });
+    }
+}
+
+void SoftwareRasterizer::renderSimulation(const FixedSimulation& simulation, uint8_t* pixels) {
+    const std::vector<uint64_t>& alive = simulation.getBrickAlive();
+    if (brickLayer.empty() || brickLayerAlive != alive) {
+        brickLayer.resize(getFrameSize());
+        clear(brickLayer.data(), BLACK);
+        const FixedVector size = simulation.getBrickSize();
+        for (int i = 0; i < simulation.getBrickCount(); i++) {
+            if (simulation.isBrickAlive(i)) {
+                const FixedVector corner = simulation.getBrickCorner(i);
+                addRect(brickLayer.data(),
+                        Rectangle{corner.x.toFloat(), corner.y.toFloat(), size.x.toFloat(), size.y.toFloat()},
+                        brickColor(simulation.getMode(), i));
+            }
+        }
+        brickLayerAlive = alive;
+    }
+    std::memcpy(pixels, brickLayer.data(), brickLayer.size());
+
+    fillRect(pixels, Rectangle{simulation.getPaddleX().toFloat(), simulation.getPaddleY().toFloat(),
+                               simulation.getPaddleWidth().toFloat(), simulation.getPaddleHeight().toFloat()},
+             BLUE);
+    const FixedVector ball = simulation.getBallPosition();
+    fillCircle(pixels, Vector2{ball.x.toFloat(), ball.y.toFloat()}, simulation.getBallRadius().toFloat(), WHITE);
+}
+
+void SoftwareRasterizer::downsample(const uint8_t* source, int sourceWidth, int sourceHeight, int channels,
+                                    uint8_t* target, int targetWidth, int targetHeight) {
+    const float stepX = static_cast<float>(sourceWidth) / targetWidth;
+    const float stepY = static_cast<float>(sourceHeight) / targetHeight;
+    std::vector<float> sum(channels);
+
+    for (int ty = 0; ty < targetHeight; ty++) {
+        const float y0 = ty * stepY;
+        const float y1 = y0 + stepY;
+        for (int tx = 0; tx < targetWidth; tx++) {
+            const float x0 = tx * stepX;
+            const float x1 = x0 + stepX;
+            std::fill(sum.begin(), sum.end(), 0.0f);
+            for (int sy = static_cast<int>(y0); sy < std::min(sourceHeight, static_cast<int>(std::ceil(y1))); sy++) {
+                const float wy = std::min(y1, sy + 1.0f) - std::max(y0, static_cast<float>(sy));
+                for (int sx = static_cast<int>(x0); sx < std::min(sourceWidth, static_cast<int>(std::ceil(x1))); sx++) {
+                    const float weight = wy * (std::min(x1, sx + 1.0f) - std::max(x0, static_cast<float>(sx)));
+                    const uint8_t* pixel = source + (static_cast<size_t>(sy) * sourceWidth + sx) * channels;
+                    for (int c = 0; c < channels; c++) {
+                        sum[c] += pixel[c] * weight;
+                    }
+                }
+            }
+            uint8_t* out = target + (static_cast<size_t>(ty) * targetWidth + tx) * channels;
+            for (int c = 0; c < channels; c++) {
+                out[c] = static_cast<uint8_t>(std::min(255.0f, sum[c] / (stepX * stepY) + 0.5f));
+            }
+        }
+    }
+}
+
+SoftwareRasterizer::Difference SoftwareRasterizer::compare(const uint8_t* a, const uint8_t* b, size_t bytes,
+                                                           int tolerance) {
+    Difference difference{0.0, 0, 0.0};
+    if (bytes == 0) {
+        return difference;
+    }
+    uint64_t total = 0;
+    size_t within = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        const int error = std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+        total += error;
+        difference.maxError = std::max(difference.maxError, error);
+        within += error <= tolerance ? 1 : 0;
+    }
+    difference.meanError = static_cast<double>(total) / bytes;
+    difference.withinTolerance = static_cast<double>(within) / bytes;
+    return difference;
+}
@@ -0,0 +1,424 @@
+#include "../include/spectator_stream.h"
+#include "../include/brick_field.h"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+    constexpr float POSITION_SCALE = 8.0f;  // 1/8 pixel
+    constexpr int MAX_CELLS = 4096;         // sanity limit for decoded keyframes
+
+    constexpr uint8_t MESSAGE_KEYFRAME = 'K';
+    constexpr uint8_t MESSAGE_DELTA = 'D';
+
+    // Delta fields present
+    enum DeltaFlags : uint8_t {
+        DELTA_PADDLE_X = 1u << 0,
+        DELTA_BALL = 1u << 1,
+        DELTA_BRICKS = 1u << 2,
+        DELTA_HUD = 1u << 3,
+        DELTA_GEOMETRY = 1u << 4
+    };
+
+    int32_t quantize(float value) {
+        return static_cast<int32_t>(std::lround(value * POSITION_SCALE));
+    }
+
+    float dequantize(int32_t value) {
+        return static_cast<float>(value) / POSITION_SCALE;
+    }
+
+    void putVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putSigned(std::vector<uint8_t>& out, int32_t value) {
+        putVarint(out, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
+    // Reads past the end or over-long varints clear ok instead of throwing
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t position;
+        bool ok;
+
+        uint8_t byte() {
+            if (position >= size) {
+                ok = false;
+                return 0;
+            }
+            return data[position++];
+        }
+
+        uint32_t varint() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                const uint8_t next = byte();
+                value |= static_cast<uint32_t>(next & 0x7F) << shift;
+                if ((next & 0x80) == 0) {
+                    return value;
+                }
+            }
+            ok = false;
+            return 0;
+        }
+
+        int32_t signedVarint() {
+            const uint32_t value = varint();
+            return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+    };
+
+    bool isAlive(const std::vector<uint64_t>& alive, int cell) {
+        return (alive[cell / 64] >> (cell % 64)) & 1;
+    }
+
+    // Assigns into model's vectors so their storage is reused frame to frame
+    void toModel(const SpectatorState& state, SpectatorModel& model) {
+        model.valid = true;
+        model.tick = state.tick;
+        model.mode = static_cast<uint8_t>(state.mode);
+        model.phase = state.phase;
+        model.score = state.score;
+        model.lives = state.lives;
+        model.level = state.level;
+        model.width = quantize(state.width);
+        model.height = quantize(state.height);
+        model.layout = state.layout;
+        model.alive = state.alive;
+        model.paddleX = quantize(state.paddle.x);
+        model.paddleY = quantize(state.paddle.y);
+        model.paddleWidth = quantize(state.paddle.width);
+        model.paddleHeight = quantize(state.paddle.height);
+        model.ballX = quantize(state.ball.x);
+        model.ballY = quantize(state.ball.y);
+        model.previousBallX = model.ballX;
+        model.previousBallY = model.ballY;
+        model.ballRadius = quantize(state.ballRadius);
+    }
+
+    void toState(const SpectatorModel& model, SpectatorState& state) {
+        state.tick = model.tick;
+        state.mode = static_cast<GameMode>(model.mode);
+        state.phase = model.phase;
+        state.score = model.score;
+        state.lives = model.lives;
+        state.level = model.level;
+        state.width = dequantize(model.width);
+        state.height = dequantize(model.height);
+        state.layout = model.layout;
+        state.alive = model.alive;
+        state.paddle = Rectangle{dequantize(model.paddleX), dequantize(model.paddleY),
+                                 dequantize(model.paddleWidth), dequantize(model.paddleHeight)};
+        state.ball = Vector2{dequantize(model.ballX), dequantize(model.ballY)};
+        state.ballRadius = dequantize(model.ballRadius);
+    }
+
+    int32_t predict(int32_t current, int32_t previous) {
+        return current + (current - previous);
+    }
+
+    void writeKeyframe(const SpectatorModel& model, std::vector<uint8_t>& out) {
+        out.push_back(MESSAGE_KEYFRAME);
+        putVarint(out, model.tick);
+        out.push_back(model.mode);
+        out.push_back(model.phase);
+        putSigned(out, model.score);
+        putSigned(out, model.lives);
+        putSigned(out, model.level);
+        putSigned(out, model.width);
+        putSigned(out, model.height);
+
+        // Layout as runs of equal hit points; most levels are a few runs
+        const int cells = static_cast<int>(model.layout.size());
+        putVarint(out, static_cast<uint32_t>(cells));
+        for (int i = 0; i < cells;) {
+            int run = 1;
+            while (i + run < cells && model.layout[i + run] == model.layout[i]) {
+                run++;
+            }
+            putVarint(out, static_cast<uint32_t>(run));
+            out.push_back(model.layout[i]);
+            i += run;
+        }
+        for (int i = 0; i < cells; i += 8) {
+            out.push_back(static_cast<uint8_t>(model.alive[i / 64] >> (i % 64)));
+        }
+
+        putSigned(out, model.paddleX);
+        putSigned(out, model.paddleY);
+        putSigned(out, model.paddleWidth);
+        putSigned(out, model.paddleHeight);
+        putSigned(out, model.ballX);
+        putSigned(out, model.ballY);
+        putSigned(out, model.ballRadius);
+    }
+
+    bool readKeyframe(Reader& reader, SpectatorModel& model) {
+        model.tick = reader.varint();
+        model.mode = reader.byte();
+        model.phase = reader.byte();
+        model.score = reader.signedVarint();
+        model.lives = reader.signedVarint();
+        model.level = reader.signedVarint();
+        model.width = reader.signedVarint();
+        model.height = reader.signedVarint();
+
+        const uint32_t cells = reader.varint();
+        if (!reader.ok || model.mode >= GAME_MODE_COUNT || cells > MAX_CELLS) {
+            return false;
+        }
+        model.layout.assign(cells, 0);
+        for (uint32_t i = 0; i < cells && reader.ok;) {
+            const uint32_t run = reader.varint();
+            const uint8_t value = reader.byte();
+            if (run == 0 || run > cells - i) {
+                return false;
+            }
+            std::memset(model.layout.data() + i, value, run);
+            i += run;
+        }
+        model.alive.assign((cells + 63) / 64, 0);
+        for (uint32_t i = 0; i < cells; i += 8) {
+            model.alive[i / 64] |= static_cast<uint64_t>(reader.byte()) << (i % 64);
+        }
+
+        model.paddleX = reader.signedVarint();
+        model.paddleY = reader.signedVarint();
+        model.paddleWidth = reader.signedVarint();
+        model.paddleHeight = reader.signedVarint();
+        model.ballX = reader.signedVarint();
+        model.ballY = reader.signedVarint();
+        model.previousBallX = model.ballX;
+        model.previousBallY = model.ballY;
+        model.ballRadius = reader.signedVarint();
+        return reader.ok;
+    }
+
+    void writeDelta(const SpectatorModel& previous, const SpectatorModel& next, std::vector<int>& flipped,
+                    std::vector<uint8_t>& out) {
+        const int32_t residualX = next.ballX - predict(previous.ballX, previous.previousBallX);
+        const int32_t residualY = next.ballY - predict(previous.ballY, previous.previousBallY);
+        bool bricksChanged = false;
+        for (size_t i = 0; i < next.alive.size(); i++) {
+            bricksChanged |= next.alive[i] != previous.alive[i];
+        }
+
+        uint8_t flags = 0;
+        flags |= next.paddleX != previous.paddleX ? DELTA_PADDLE_X : 0;
+        flags |= residualX != 0 || residualY != 0 ? DELTA_BALL : 0;
+        flags |= bricksChanged ? DELTA_BRICKS : 0;
+        flags |= next.phase != previous.phase || next.score != previous.score || next.lives != previous.lives ||
+                 next.level != previous.level ? DELTA_HUD : 0;
+        flags |= next.paddleY != previous.paddleY || next.paddleWidth != previous.paddleWidth ||
+                 next.paddleHeight != previous.paddleHeight || next.ballRadius != previous.ballRadius
+                 ? DELTA_GEOMETRY : 0;
+
+        out.push_back(MESSAGE_DELTA);
+        putVarint(out, next.tick - previous.tick);
+        out.push_back(flags);
+        if (flags & DELTA_PADDLE_X) {
+            putSigned(out, next.paddleX - previous.paddleX);
+        }
+        if (flags & DELTA_BALL) {
+            putSigned(out, residualX);
+            putSigned(out, residualY);
+        }
+        if (flags & DELTA_BRICKS) {
+            // Flipped cells as gaps between ascending indices
+            flipped.clear();
+            for (int cell = 0; cell < static_cast<int>(next.layout.size()); cell++) {
+                if (isAlive(next.alive, cell) != isAlive(previous.alive, cell)) {
+                    flipped.push_back(cell);
+                }
+            }
+            putVarint(out, static_cast<uint32_t>(flipped.size()));
+            int last = -1;
+            for (int cell : flipped) {
+                putVarint(out, static_cast<uint32_t>(cell - last - 1));
+                last = cell;
+            }
+        }
+        if (flags & DELTA_HUD) {
+            out.push_back(next.phase);
+            putSigned(out, next.score - previous.score);
+            putSigned(out, next.lives - previous.lives);
+            putSigned(out, next.level - previous.level);
+        }
+        if (flags & DELTA_GEOMETRY) {
+            putSigned(out, next.paddleY);
+            putSigned(out, next.paddleWidth);
+            putSigned(out, next.paddleHeight);
+            putSigned(out, next.ballRadius);
+        }
+    }
+
+    bool readDelta(Reader& reader, SpectatorModel& model) {
+        model.tick += reader.varint();
+        const uint8_t flags = reader.byte();
+        if (flags & DELTA_PADDLE_X) {
+            model.paddleX += reader.signedVarint();
+        }
+
+        int32_t residualX = 0;
+        int32_t residualY = 0;
+        if (flags & DELTA_BALL) {
+            residualX = reader.signedVarint();
+            residualY = reader.signedVarint();
+        }
+        const int32_t ballX = predict(model.ballX, model.previousBallX) + residualX;
+        const int32_t ballY = predict(model.ballY, model.previousBallY) + residualY;
+        model.previousBallX = model.ballX;
+        model.previousBallY = model.ballY;
+        model.ballX = ballX;
+        model.ballY = ballY;
+
+        if (flags & DELTA_BRICKS) {
+            const uint32_t count = reader.varint();
+            int cell = -1;
+            for (uint32_t i = 0; i < count && reader.ok; i++) {
+                cell += static_cast<int>(reader.varint()) + 1;
+                if (cell < 0 || cell >= static_cast<int>(model.layout.size())) {
+                    return false;
+                }
+                model.alive[cell / 64] ^= 1ull << (cell % 64);
+            }
+        }
+        if (flags & DELTA_HUD) {
+            model.phase = reader.byte();
+            model.score += reader.signedVarint();
+            model.lives += reader.signedVarint();
+            model.level += reader.signedVarint();
+        }
+        if (flags & DELTA_GEOMETRY) {
+            model.paddleY = reader.signedVarint();
+            model.paddleWidth = reader.signedVarint();
+            model.paddleHeight = reader.signedVarint();
+            model.ballRadius = reader.signedVarint();
+        }
+        return reader.ok;
+    }
+}
+
+int spectatorCellCount(GameMode mode) {
+    switch (mode) {
+        case GameMode::CLASSIC:   return BrickLayout<ClassicConfig>::COUNT;
+        case GameMode::MEGA_GRID: return BrickLayout<MegaGridConfig>::COUNT;
+        case GameMode::CHAOS:     return BrickLayout<ChaosConfig>::COUNT;
+        case GameMode::ENDLESS:   return BrickLayout<EndlessConfig>::COUNT;
+    }
+    return 0;
+}
+
+void captureSpectatorState(const World& world, const std::vector<uint8_t>& layout, SpectatorState& state) {
+    const int cells = spectatorCellCount(state.mode);
+    if (static_cast<int>(layout.size()) == cells) {
+        state.layout = layout;
+    } else {
+        state.layout.assign(cells, 1);
+    }
+    state.alive.assign((cells + 63) / 64, 0);
+    world.each<GridCell>([&](Entity, const GridCell& cell) {
+        if (cell.index >= 0 && cell.index < cells) {
+            state.alive[cell.index / 64] |= 1ull << (cell.index % 64);
+        }
+    });
+    world.each<Position, Collider, PaddleTag>([&](Entity, const Position& position, const Collider& collider,
+                                                  const PaddleTag&) {
+        state.paddle = Rectangle{position.x, position.y, collider.width, collider.height};
+    });
+    world.each<Position, Collider, BallTag>([&](Entity, const Position& position, const Collider& collider,
+                                                const BallTag&) {
+        state.ball = Vector2{position.x, position.y};
+        state.ballRadius = collider.radius;
+    });
+}
+
+SpectatorEncoder::SpectatorEncoder()
+    : model{}, next{}, lastKeyframeTick(0), keyframeRequested(true), messages(0), keyframes(0), bytes(0) {}
+
+bool SpectatorEncoder::needsKeyframe(const SpectatorModel& next) const {
+    if (!model.valid || keyframeRequested || next.tick < model.tick ||
+        next.tick - lastKeyframeTick >= KEYFRAME_INTERVAL || next.mode != model.mode ||
+        next.width != model.width || next.height != model.height || next.layout != model.layout) {
+        return true;
+    }
+    // Bricks only ever die during a game; one coming back means a new field
+    for (size_t i = 0; i < next.alive.size(); i++) {
+        if (next.alive[i] & ~model.alive[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SpectatorEncoder::encode(const SpectatorState& state, std::vector<uint8_t>& message) {
+    const size_t start = message.size();
+    toModel(state, next);
+    if (needsKeyframe(next)) {
+        writeKeyframe(next, message);
+        lastKeyframeTick = next.tick;
+        keyframeRequested = false;
+        keyframes++;
+    } else {
+        next.previousBallX = model.ballX;
+        next.previousBallY = model.ballY;
+        writeDelta(model, next, flipped, message);
+    }
+    // The old model becomes next frame's scratch
+    std::swap(model, next);
+    messages++;
+    bytes += message.size() - start;
+}
+
+SpectatorDecoder::SpectatorDecoder() : model{}, next{}, state{} {}
+
+bool SpectatorDecoder::decode(const uint8_t* data, size_t size) {
+    Reader reader{data, size, 0, true};
+    const uint8_t type = reader.byte();
+    next = model;  // copy-assigns into next's existing storage
+    bool ok = false;
+    if (type == MESSAGE_KEYFRAME) {
+        ok = readKeyframe(reader, next);
+    } else if (type == MESSAGE_DELTA && model.valid) {
+        ok = readDelta(reader, next);
+    }
+    if (!ok || reader.position != size) {
+        return false;
+    }
+    next.valid = true;
+    std::swap(model, next);
+    toState(model, state);
+    return true;
+}
+
+void frameMessage(const std::vector<uint8_t>& message, std::vector<uint8_t>& out) {
+    putVarint(out, static_cast<uint32_t>(message.size()));
+    out.insert(out.end(), message.begin(), message.end());
+}
+
+void StreamFramer::feed(const uint8_t* data, size_t size) {
+    // Drop consumed bytes once they dominate the buffer
+    if (readOffset > 0 && readOffset * 2 >= buffer.size()) {
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(readOffset));
+        readOffset = 0;
+    }
+    buffer.insert(buffer.end(), data, data + size);
+}
+
+bool StreamFramer::next(std::vector<uint8_t>& message) {
+    Reader reader{buffer.data() + readOffset, buffer.size() - readOffset, 0, true};
+    const uint32_t length = reader.varint();
+    if (!reader.ok || reader.size - reader.position < length) {
+        return false;  // incomplete
+    }
+    const uint8_t* begin = reader.data + reader.position;
+    message.assign(begin, begin + length);
+    readOffset += reader.position + length;
+    return true;
+}
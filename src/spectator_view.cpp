@@ -0,0 +1,68 @@
+#include "../include/spectator_view.h"
+#include "../include/brick_field.h"
+#include "../include/systems.h"
+
+namespace {
+    bool isAlive(const std::vector<uint64_t>& alive, int cell) {
+        return (alive[cell / 64] >> (cell % 64)) & 1;
+    }
+
+    template <typename Config>
+    void spawnBricks(World& world, const SpectatorState& state) {
+        const LevelDesign design{state.mode, 0, state.level, state.layout};
+        BrickField<Config>::spawn(world, state.width, state.height, design);
+    }
+}
+
+SpectatorView::SpectatorView() : paddle(NULL_ENTITY), ball(NULL_ENTITY), state{}, valid(false) {}
+
+void SpectatorView::rebuild(const SpectatorState& next) {
+    world.clear();
+    switch (next.mode) {
+        case GameMode::CLASSIC:   spawnBricks<ClassicConfig>(world, next); break;
+        case GameMode::MEGA_GRID: spawnBricks<MegaGridConfig>(world, next); break;
+        case GameMode::CHAOS:     spawnBricks<ChaosConfig>(world, next); break;
+        case GameMode::ENDLESS:   spawnBricks<EndlessConfig>(world, next); break;
+    }
+    cells.assign(next.layout.size(), NULL_ENTITY);
+    world.each<GridCell>([&](Entity entity, const GridCell& cell) {
+        cells[cell.index] = entity;
+    });
+
+    const Playfield playfield{next.width, next.height, next.width / 800.0f, next.height / 600.0f};
+    paddle = spawnPaddle(world, playfield, 0.0f);
+    ball = spawnBall(world, playfield, 0.0f);
+}
+
+void SpectatorView::apply(const SpectatorState& next) {
+    bool revived = false;
+    for (size_t i = 0; valid && i < next.alive.size() && i < state.alive.size(); i++) {
+        revived |= (next.alive[i] & ~state.alive[i]) != 0;
+    }
+    if (!valid || revived || next.mode != state.mode || next.layout != state.layout ||
+        next.width != state.width || next.height != state.height) {
+        rebuild(next);
+    }
+
+    for (int cell = 0; cell < static_cast<int>(cells.size()); cell++) {
+        if (cells[cell] != NULL_ENTITY && !isAlive(next.alive, cell)) {
+            world.destroy(cells[cell]);
+            cells[cell] = NULL_ENTITY;
+        }
+    }
+
+    world.get<Position>(paddle) = Position{next.paddle.x, next.paddle.y};
+    Collider& paddleCollider = world.get<Collider>(paddle);
+    paddleCollider.width = next.paddle.width;
+    paddleCollider.height = next.paddle.height;
+    world.get<Position>(ball) = Position{next.ball.x, next.ball.y};
+    world.get<Collider>(ball).radius = next.ballRadius;
+
+    state = next;
+    valid = true;
+}
+
+void SpectatorView::buildRenderCommands(RenderCommandBuffer& commands) const {
+    renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, commands);
+    renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, commands);
+}
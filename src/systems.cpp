@@ -0,0 +1,196 @@
+#include "../include/systems.h"
+#include "../include/rotation_tables.h"
+#include <cmath>
+
+namespace {
+    // Collision response works on direction vectors; the rotations it needs
+    // come from the shared integer-generated tables, converted once to float
+    constexpr int DEFLECTION_STEPS = RotationTables::DEFLECTION_STEPS;
+    constexpr float PADDLE_HIT_RANGE = RotationTables::PADDLE_HIT_RANGE;
+    constexpr int PERTURBATION_STEPS = RotationTables::PERTURBATION_STEPS;
+
+    // Exact: int64 -> float rounds once, the division is by a power of two
+    constexpr Vector2 toVector(RotationTables::Rotation rotation) {
+        return Vector2{ static_cast<float>(rotation.x) / RotationTables::ONE,
+                        static_cast<float>(rotation.y) / RotationTables::ONE };
+    }
+
+    struct FloatRotations {
+        Vector2 deflection[DEFLECTION_STEPS];
+        Vector2 perturbation[PERTURBATION_STEPS];
+
+        FloatRotations() : deflection{}, perturbation{} {
+            for (int i = 0; i < DEFLECTION_STEPS; i++) {
+                deflection[i] = toVector(RotationTables::DEFLECTION[i]);
+            }
+            for (int i = 0; i < PERTURBATION_STEPS; i++) {
+                perturbation[i] = toVector(RotationTables::PERTURBATION[i]);
+            }
+        }
+    };
+
+    const FloatRotations ROTATIONS;
+
+    Vector2 rotate(Vector2 v, Vector2 rotation) {
+        return Vector2{ v.x * rotation.x - v.y * rotation.y, v.x * rotation.y + v.y * rotation.x };
+    }
+}
+
+Entity spawnPaddle(World& world, const Playfield& playfield, float speed) {
+    return world.create<PaddleArchetype>(
+        Position{(playfield.width - PaddleTuning::BASE_WIDTH * playfield.widthScale) / 2,
+                 playfield.height * PaddleTuning::Y_FRACTION},
+        Velocity{0.0f, 0.0f, speed, 0.0f},
+        Collider{ColliderShape::BOX, PaddleTuning::BASE_WIDTH, PaddleTuning::BASE_HEIGHT, 0.0f,
+                 PaddleTuning::BASE_WIDTH, PaddleTuning::BASE_HEIGHT, 0.0f, -1},
+        Render{BLUE, RenderLayer::DYNAMIC},
+        PaddleTag{}
+    );
+}
+
+Entity spawnBall(World& world, const Playfield& playfield, float speed) {
+    // Launches up and to the right at 45 degrees with speed per axis
+    const float diagonal = 0.70710678f;
+    return world.create<BallArchetype>(
+        Position{playfield.width / 2,
+                 playfield.height * PaddleTuning::Y_FRACTION - BallTuning::BASE_RADIUS * playfield.heightScale},
+        Velocity{diagonal, -diagonal, speed / diagonal, 0.0f},
+        Collider{ColliderShape::CIRCLE, 0.0f, 0.0f, BallTuning::BASE_RADIUS, 0.0f, 0.0f, BallTuning::BASE_RADIUS, -1},
+        Render{WHITE, RenderLayer::DYNAMIC},
+        BallTag{}
+    );
+}
+
+void paddleInputSystem(World& world, const PaddleInput& input) {
+    world.each<Position, Velocity, PaddleTag>([&](Entity, Position& position, Velocity& velocity, PaddleTag&) {
+        velocity.dirX = input.axis;
+        position.x += input.dragDelta;
+    });
+}
+
+void movementSystem(World& world, float deltaTime, const Playfield& playfield) {
+    const float decay = BallTuning::SPIN_DECAY * deltaTime;
+
+    world.each<Position, Velocity>([&](Entity, Position& position, Velocity& velocity) {
+        // Spin bends the horizontal component; it is zero for paddles and power-ups
+        float speedX = velocity.dirX * velocity.speed;
+        float spinInfluence = velocity.spin * BallTuning::SPIN_INFLUENCE;
+        position.x += (speedX + speedX * spinInfluence) * playfield.widthScale * deltaTime;
+        position.y += velocity.dirY * velocity.speed * playfield.heightScale * deltaTime;
+
+        // Decay spin over time
+        if (velocity.spin > 0.0f) {
+            velocity.spin = std::max(0.0f, velocity.spin - decay);
+        } else if (velocity.spin < 0.0f) {
+            velocity.spin = std::min(0.0f, velocity.spin + decay);
+        }
+    });
+}
+
+void containmentSystem(World& world, const Playfield& playfield) {
+    world.each<Position, Collider, PaddleTag>([&](Entity, Position& position, Collider& collider, PaddleTag&) {
+        position.x = std::max(0.0f, std::min(position.x, playfield.width - collider.width));
+    });
+
+    world.each<Position, Velocity, Collider, BallTag>([&](Entity, Position& position, Velocity& velocity,
+                                                         Collider& collider, BallTag&) {
+        bounceOffWalls(position, velocity, collider, playfield);
+    });
+}
+
+bool bounceOffWalls(Position& ball, Velocity& velocity, const Collider& collider, const Playfield& playfield) {
+    // Side and top edges only. The bottom edge is left open, that's for life
+    // loss detection
+    bool bounced = false;
+    if (ball.x - collider.radius < 0) {
+        ball.x = collider.radius;
+        velocity.dirX = -velocity.dirX;
+        bounced = true;
+    }
+    if (ball.x + collider.radius > playfield.width) {
+        ball.x = playfield.width - collider.radius;
+        velocity.dirX = -velocity.dirX;
+        bounced = true;
+    }
+    if (ball.y - collider.radius < 0) {
+        ball.y = collider.radius;
+        velocity.dirY = -velocity.dirY;
+        bounced = true;
+    }
+    return bounced;
+}
+
+void resizeSystem(World& world, const Playfield& playfield) {
+    // Bricks are relaid from their grid cell instead, see BrickField::layout
+    world.each<Collider, Velocity>([&](Entity, Collider& collider, Velocity&) {
+        if (collider.shape == ColliderShape::BOX) {
+            collider.width = collider.baseWidth * playfield.widthScale;
+            collider.height = collider.baseHeight * playfield.heightScale;
+        } else {
+            // Use the average of width and height scale for the radius
+            collider.radius = collider.baseRadius * (playfield.widthScale + playfield.heightScale) * 0.5f;
+        }
+    });
+}
+
+bool resolveBallPaddle(Position& ball, Velocity& velocity, const Collider& collider,
+                       const Rectangle& paddle, float paddleAxis, float& hitOffset) {
+    if (!circleOverlapsRect(Vector2{ball.x, ball.y}, collider.radius, paddle)) {
+        return false;
+    }
+
+    // Calculate hit position relative to paddle center (-1 to 1)
+    hitOffset = (ball.x - (paddle.x + paddle.width / 2)) / (paddle.width / 2);
+
+    // Move ball above paddle to prevent sticking
+    ball.y = paddle.y - collider.radius;
+
+    // Deflect from straight up by up to 60 degrees at the paddle edge;
+    // the rotation comes from a table and the speed is left untouched
+    float step = (std::clamp(hitOffset, -PADDLE_HIT_RANGE, PADDLE_HIT_RANGE) + PADDLE_HIT_RANGE) *
+                 ((DEFLECTION_STEPS - 1) / (2.0f * PADDLE_HIT_RANGE));
+    Vector2 direction = ROTATIONS.deflection[static_cast<int>(step + 0.5f)];
+    velocity.dirX = direction.x;
+    velocity.dirY = direction.y;
+
+    // Add spin based on hit position and current paddle movement
+    addSpin(velocity, (hitOffset + paddleAxis * 0.5f) * 0.5f);
+    return true;
+}
+
+bool resolveBallBrick(Position& ball, Velocity& velocity, const Collider& collider,
+                      const Rectangle& brick, uint32_t random) {
+    if (!circleOverlapsRect(Vector2{ball.x, ball.y}, collider.radius, brick)) {
+        return false;
+    }
+
+    float dx = ball.x - (brick.x + brick.width / 2.0f);
+    float dy = ball.y - (brick.y + brick.height / 2.0f);
+
+    // Determine if this is a corner collision
+    bool isCornerCollision = (std::fabs(dx) > brick.width * 0.4f &&
+                              std::fabs(dy) > brick.height * 0.4f);
+
+    if (isCornerCollision) {
+        // For corner collisions, leave along the contact normal from the
+        // brick centre, rotated slightly to prevent chain reactions (±5 degrees).
+        // Corners are rare, so the one normalisation here is cheap.
+        float inverseLength = 1.0f / std::sqrt(dx * dx + dy * dy);
+        Vector2 normal = { dx * inverseLength, dy * inverseLength };
+        Vector2 direction = rotate(normal, ROTATIONS.perturbation[random % PERTURBATION_STEPS]);
+        velocity.dirX = direction.x;
+        velocity.dirY = direction.y;
+
+        // Add slight spin based on which corner was hit
+        addSpin(velocity, (dx > 0) ? 0.2f : -0.2f);
+    } else if (std::fabs(dx) * brick.height > std::fabs(dy) * brick.width) {
+        // Side face: reflect and add spin based on the vertical position of the hit
+        reflect(velocity, Vector2{1.0f, 0.0f});
+        addSpin(velocity, (dy > 0) ? 0.1f : -0.1f);
+    } else {
+        // Top/bottom face: reflect and add spin based on the horizontal position of the hit
+        reflect(velocity, Vector2{0.0f, 1.0f});
+        addSpin(velocity, (dx > 0) ? -0.1f : 0.1f);
+    }
+    return true;
+}
@@ -0,0 +1,138 @@
+#include "../include/telemetry.h"
+#include "../include/memory_tracker.h"
+#include "../include/persistent_storage.h"
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+    struct EventSchema {
+        TelemetryEventType type;
+        const char* name;
+        const char* fields[3];
+    };
+
+    // Embedded in every session's schema chunk so the reader never needs this table
+    const EventSchema SCHEMA[] = {
+        { TelemetryEventType::GAME_START, "game_start", { "mode", "", "" } },
+        { TelemetryEventType::GAME_END,   "game_end",   { "won", "score", "duration_ms" } },
+        { TelemetryEventType::BRICK_HIT,  "brick_hit",  { "brick", "x", "y" } },
+        { TelemetryEventType::PADDLE_HIT, "paddle_hit", { "rally_hits", "offset_permille", "" } },
+        { TelemetryEventType::LIFE_LOST,  "life_lost",  { "lives_left", "x", "" } },
+        { TelemetryEventType::RALLY_END,  "rally_end",  { "paddle_hits", "duration_ms", "" } },
+    };
+
+    template <typename T>
+    void appendValue(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void appendString(std::string& out, const char* text) {
+        appendValue(out, static_cast<uint8_t>(strlen(text)));
+        out.append(text);
+    }
+
+    // FNV-1a
+    uint32_t hashBytes(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    struct BatchHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t schemaId;
+        uint32_t recordCount;
+    };
+    static_assert(sizeof(BatchHeader) == 16, "batch headers are packed");
+}
+
+Telemetry::Telemetry(const char* fileName)
+    : head(0), tail(0), nowMs(0), dropped(0), written(0), failedWrites(0), schemaId(0), schemaWritten(false) {
+    MemoryScope scope(MemoryTag::TELEMETRY);
+    ring.reset(new TelemetryRecord[CAPACITY]);
+    path = PersistentStorage::pathFor(fileName);
+
+    // Everything after the id; the id is its hash
+    std::string schema;
+    appendValue(schema, static_cast<uint8_t>(sizeof(SCHEMA) / sizeof(SCHEMA[0])));
+    for (const EventSchema& entry : SCHEMA) {
+        appendValue(schema, static_cast<uint8_t>(entry.type));
+        appendString(schema, entry.name);
+        for (const char* field : entry.fields) {
+            appendString(schema, field);
+        }
+    }
+    std::string versioned;
+    appendValue(versioned, FORMAT_VERSION);
+    appendValue(versioned, static_cast<uint16_t>(sizeof(TelemetryRecord)));
+    schemaId = hashBytes((versioned + schema).data(), versioned.size() + schema.size());
+
+    schemaChunk = "BKTS" + versioned;
+    appendValue(schemaChunk, schemaId);
+    schemaChunk += schema;
+}
+
+FILE* Telemetry::openLog() {
+    if (!schemaWritten) {
+        // Chunks can't be appended to a log in the old single-header format
+        FILE* existing = fopen(path.c_str(), "rb");
+        if (existing) {
+            char magic[4];
+            const bool legacy = fread(magic, 1, 4, existing) == 4 && memcmp(magic, "BKTL", 4) == 0;
+            fclose(existing);
+            if (legacy) {
+                rename(path.c_str(), (path + ".v1").c_str());
+            }
+        }
+    }
+    return fopen(path.c_str(), "ab");
+}
+
+void Telemetry::flush() {
+    if (head == tail || !PersistentStorage::isReady()) {
+        return;
+    }
+
+    FILE* file = openLog();
+    if (!file) {
+        return;
+    }
+    // Where this flush's chunks start, to cut a partial write back off
+    const long start = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+
+    bool ok = start >= 0;
+    if (ok && !schemaWritten) {
+        ok = fwrite(schemaChunk.data(), 1, schemaChunk.size(), file) == schemaChunk.size();
+    }
+
+    const uint32_t pending = head - tail;
+    const BatchHeader header{{'B', 'K', 'T', 'B'}, FORMAT_VERSION, sizeof(TelemetryRecord), schemaId, pending};
+    ok = ok && fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // The pending range may wrap around the end of the ring
+    const uint32_t first = tail & (CAPACITY - 1);
+    const uint32_t firstChunk = pending < CAPACITY - first ? pending : CAPACITY - first;
+    ok = ok && fwrite(&ring[first], sizeof(TelemetryRecord), firstChunk, file) == firstChunk;
+    ok = ok && fwrite(&ring[0], sizeof(TelemetryRecord), pending - firstChunk, file) == pending - firstChunk;
+    // fclose flushes the buffered bytes, so a full disk often only shows here
+    ok = fclose(file) == 0 && ok;
+
+    // A torn chunk would end the file for the reader, so it's cut off and
+    // the records stay queued for the next flush (the schema chunk too, if
+    // it was part of this one)
+    if (!ok) {
+        if (start >= 0) {
+            truncate(path.c_str(), start);
+        }
+        failedWrites++;
+        return;
+    }
+    schemaWritten = true;
+    tail = head;
+    written += pending;
+    PersistentStorage::sync();
+}
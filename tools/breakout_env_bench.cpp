@@ -0,0 +1,111 @@
+// Vectorized environment benchmark (native).
+//
+// Steps batches of environments through the C ABI with random actions and
+// reports env-steps and simulated frames per second. Every configuration is
+// also run single-threaded; the checksums over all observations, rewards and
+// done flags must match, since threads only split the batch.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/breakout_env_bench.cpp src/breakout_env.cpp src/software_raster.cpp
+//       src/fixed_simulation.cpp -o breakout_env_bench
+//   ./breakout_env_bench [steps] [threads]
+//
+// The library itself, for Python (ctypes) or other hosts:
+//   g++ -std=c++17 -O2 -pthread -shared -fPIC -Iinclude -Ivendor/raylib-emscripten/include
+//       src/breakout_env.cpp src/software_raster.cpp src/fixed_simulation.cpp -o libbreakout_env.so
+
+#include "../include/breakout_env.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct RunResult {
+        double seconds;
+        uint64_t checksum;
+        long long episodes;
+    };
+
+    uint64_t mix(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    RunResult run(int count, int framesPerStep, int threads, int steps) {
+        BreakoutEnvConfig config = breakout_env_default_config();
+        config.frames_per_step = framesPerStep;
+        config.threads = threads;
+        config.seed = 2024;
+        BreakoutEnv* env = breakout_env_create(count, &config);
+
+        const int words = breakout_env_brick_words(env);
+        std::vector<int8_t> actions(count);
+        std::vector<float> observations(static_cast<size_t>(count) * BREAKOUT_ENV_STATE_SIZE);
+        std::vector<uint64_t> bricks(static_cast<size_t>(count) * words);
+        std::vector<float> rewards(count);
+        std::vector<uint8_t> dones(count);
+        breakout_env_reset(env, observations.data(), bricks.data());
+
+        uint32_t rng = 12345;
+        uint64_t checksum = 14695981039346656037ull;
+        long long episodes = 0;
+        double seconds = 0.0;
+        for (int step = 0; step < steps; step++) {
+            for (int8_t& action : actions) {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                action = static_cast<int8_t>(rng % 3) - 1;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            breakout_env_step(env, actions.data(), observations.data(), bricks.data(), rewards.data(), dones.data());
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            checksum = mix(checksum, observations.data(), observations.size() * sizeof(float));
+            checksum = mix(checksum, rewards.data(), rewards.size() * sizeof(float));
+            checksum = mix(checksum, dones.data(), dones.size());
+            for (uint8_t done : dones) {
+                episodes += done != 0 ? 1 : 0;
+            }
+        }
+        breakout_env_destroy(env);
+        return RunResult{seconds, checksum, episodes};
+    }
+}
+
+int main(int argc, char** argv) {
+    const int steps = argc > 1 ? std::atoi(argv[1]) : 500;
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    const int threads = argc > 2 ? std::atoi(argv[2]) : hardware;
+
+    std::printf("%6s %7s %7s %14s %14s %9s %6s\n", "envs", "frames", "threads", "env-steps/s", "frames/s",
+                "episodes", "match");
+    bool mismatch = false;
+    for (int count : { 256, 4096 }) {
+        for (int framesPerStep : { 1, 4 }) {
+            RunResult single = run(count, framesPerStep, 1, steps);
+            RunResult result = threads > 1 ? run(count, framesPerStep, threads, steps) : single;
+            const bool match = result.checksum == single.checksum;
+            mismatch |= !match;
+
+            const double envSteps = static_cast<double>(count) * steps;
+            for (const RunResult* shown : { &single, &result }) {
+                if (shown == &result && threads <= 1) {
+                    break;
+                }
+                std::printf("%6d %7d %7d %14.0f %14.0f %9lld %6s\n", count, framesPerStep,
+                            shown == &single ? 1 : threads, envSteps / shown->seconds,
+                            envSteps * framesPerStep / shown->seconds, shown->episodes, match ? "yes" : "NO");
+            }
+        }
+    }
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+// Compile-time brick layouts against a runtime config (native).
+//
+// For each mode, lays out a full field with BrickField<Config>::layout (the
+// constexpr table and fixed COUNT trip count) and with a generic version
+// that takes rows, columns and geometry as runtime values and computes every
+// cell from them, the way initializeBricks and updateCamera did before the
+// configs existed. Both must put every brick in the same place.
+//
+// Reports nanoseconds per full-field relayout and per brick, and the speedup.
+// Layout runs on every resize and every level start.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/brick_layout_bench.cpp -o brick_layout_bench
+//   ./brick_layout_bench [relayouts]
+
+#include "../include/brick_field.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    struct RuntimeConfig {
+        int rows;
+        int cols;
+        float brickSpacing;
+        float brickHeight;
+        float fieldTop;
+    };
+
+    // Read through a volatile so the values can't be folded back into constants
+    template <typename Config>
+    RuntimeConfig runtimeConfig() {
+        volatile int rows = Config::ROWS;
+        volatile int cols = Config::COLS;
+        volatile float spacing = Config::BRICK_SPACING;
+        volatile float height = Config::BRICK_HEIGHT;
+        volatile float top = Config::FIELD_TOP;
+        return RuntimeConfig{rows, cols, spacing, height, top};
+    }
+
+    void runtimeLayout(World& world, const RuntimeConfig& config, float screenWidth, float screenHeight) {
+        const float widthFraction = (1.0f - config.brickSpacing * (config.cols + 1)) / config.cols;
+        const float width = screenWidth * widthFraction;
+        const float height = screenHeight * config.brickHeight;
+        world.each<Position, Collider, GridCell>([&](Entity, Position& position, Collider& collider,
+                                                      GridCell& cell) {
+            const int row = cell.index / config.cols;
+            const int col = cell.index % config.cols;
+            position.x = screenWidth * (config.brickSpacing + col * (widthFraction + config.brickSpacing));
+            position.y = screenWidth * config.brickSpacing * (row + 1) +
+                         screenHeight * (row * config.brickHeight + config.fieldTop);
+            collider.width = width;
+            collider.height = height;
+        });
+    }
+
+    float maxDifference(const World& a, const World& b) {
+        const std::vector<Position>& left = a.archetype<BrickArchetype>().column<Position>();
+        const std::vector<Position>& right = b.archetype<BrickArchetype>().column<Position>();
+        float worst = 0.0f;
+        for (size_t i = 0; i < left.size(); i++) {
+            worst = std::max({worst, std::fabs(left[i].x - right[i].x), std::fabs(left[i].y - right[i].y)});
+        }
+        return worst;
+    }
+
+    template <typename Config>
+    bool compare(int relayouts) {
+        using Field = BrickField<Config>;
+        const RuntimeConfig config = runtimeConfig<Config>();
+        World specialised;
+        World generic;
+        Field::spawn(specialised, 1280.0f, 720.0f);
+        Field::spawn(generic, 1280.0f, 720.0f);
+
+        // Sizes a window goes through while being dragged
+        auto sizeAt = [](int i, float& width, float& height) {
+            width = 640.0f + static_cast<float>(i % 1280);
+            height = 480.0f + static_cast<float>((i * 7) % 600);
+        };
+
+        float width = 0.0f, height = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < relayouts; i++) {
+            sizeAt(i, width, height);
+            Field::layout(specialised, width, height);
+        }
+        const double specialisedSeconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < relayouts; i++) {
+            sizeAt(i, width, height);
+            runtimeLayout(generic, config, width, height);
+        }
+        const double genericSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const float difference = maxDifference(specialised, generic);
+        const bool ok = difference < 1e-3f;
+        const double perField = 1e9 / relayouts;
+        std::printf("%-10s %6d %12.1f %12.1f %10.2f %10.2f %8.2fx %10.1e %4s\n", Config::NAME, Field::COUNT,
+                    specialisedSeconds * perField, genericSeconds * perField,
+                    specialisedSeconds * perField / Field::COUNT, genericSeconds * perField / Field::COUNT,
+                    genericSeconds / specialisedSeconds, difference, ok ? "ok" : "DIFF");
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int relayouts = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::printf("%-10s %6s %12s %12s %10s %10s %9s %10s %4s\n", "mode", "bricks", "const ns", "runtime ns",
+                "const/brk", "rt/brk", "speedup", "max diff", "");
+    bool ok = true;
+    ok &= compare<ClassicConfig>(relayouts);
+    ok &= compare<MegaGridConfig>(relayouts);
+    ok &= compare<ChaosConfig>(relayouts);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+// Sweep-and-prune broadphase check and benchmark against brute force (native).
+//
+// Moves boxes around a field for a number of frames (bouncing off its
+// edges, with mixed categories and masks like bricks, balls, paddles and
+// power-ups) and every frame asks SweepAndPrune and an O(n^2) all-pairs
+// test for the overlapping pairs. The pair sets must match every frame.
+// Every frame about 1% of the boxes are removed or re-added, the way
+// destroyed bricks and collected capsules leave the broadphase.
+//
+// Reports milliseconds per frame for both and the average insertion-sort
+// swaps per frame.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/broadphase_bench.cpp src/broadphase.cpp -o broadphase_bench
+//   ./broadphase_bench [bodies] [frames]
+
+#include "../include/broadphase.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr float FIELD_WIDTH = 4000.0f;
+    constexpr float FIELD_HEIGHT = 3000.0f;
+
+    struct Box {
+        Rectangle bounds;
+        float vx;
+        float vy;
+        unsigned int category;
+        unsigned int mask;
+        int handle;
+    };
+
+    uint32_t nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    float randomFloat(uint32_t& state, float low, float high) {
+        return low + (high - low) * static_cast<float>(nextRandom(state) % 65536) / 65536.0f;
+    }
+
+    bool overlaps(const Rectangle& a, const Rectangle& b) {
+        return a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height;
+    }
+
+    void bruteForce(const std::vector<Box>& boxes, std::vector<SweepAndPrune::Pair>& pairs) {
+        pairs.clear();
+        for (size_t i = 0; i < boxes.size(); i++) {
+            if (boxes[i].handle < 0) {
+                continue;
+            }
+            for (size_t j = i + 1; j < boxes.size(); j++) {
+                const Box& a = boxes[i];
+                const Box& b = boxes[j];
+                if (b.handle < 0 || !((a.mask & b.category) || (b.mask & a.category)) ||
+                    !overlaps(a.bounds, b.bounds)) {
+                    continue;
+                }
+                pairs.push_back(SweepAndPrune::Pair{std::min(a.handle, b.handle), std::max(a.handle, b.handle)});
+            }
+        }
+    }
+
+    void sortPairs(std::vector<SweepAndPrune::Pair>& pairs) {
+        std::sort(pairs.begin(), pairs.end(), [](const SweepAndPrune::Pair& x, const SweepAndPrune::Pair& y) {
+            return x.a < y.a || (x.a == y.a && x.b < y.b);
+        });
+    }
+
+    bool samePairs(const std::vector<SweepAndPrune::Pair>& x, const std::vector<SweepAndPrune::Pair>& y) {
+        if (x.size() != y.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < x.size(); i++) {
+            if (x[i].a != y[i].a || x[i].b != y[i].b) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int bodies = argc > 1 ? std::atoi(argv[1]) : 3000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    // Category bits as the game uses them: ball, paddle, brick, power-up
+    const unsigned int categories[] = { 1u, 2u, 4u, 8u };
+    const unsigned int masks[] = { 2u | 4u, 1u | 8u, 0u, 2u };
+
+    uint32_t rng = 12345;
+    SweepAndPrune broadphase;
+    std::vector<Box> boxes(bodies);
+    for (int i = 0; i < bodies; i++) {
+        Box& box = boxes[i];
+        const int kind = i % 4;
+        box.bounds = Rectangle{randomFloat(rng, 0.0f, FIELD_WIDTH), randomFloat(rng, 0.0f, FIELD_HEIGHT),
+                               randomFloat(rng, 10.0f, 60.0f), randomFloat(rng, 10.0f, 30.0f)};
+        box.vx = randomFloat(rng, -4.0f, 4.0f);
+        box.vy = randomFloat(rng, -4.0f, 4.0f);
+        box.category = categories[kind];
+        box.mask = masks[kind];
+        box.handle = broadphase.add(box.bounds, box.category, box.mask, i);
+    }
+
+    std::vector<SweepAndPrune::Pair> sapPairs;
+    std::vector<SweepAndPrune::Pair> brutePairs;
+    double sapSeconds = 0.0;
+    double bruteSeconds = 0.0;
+    long long swaps = 0;
+    long long pairCount = 0;
+    int mismatches = 0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        for (Box& box : boxes) {
+            box.bounds.x += box.vx;
+            box.bounds.y += box.vy;
+            if (box.bounds.x < 0.0f || box.bounds.x + box.bounds.width > FIELD_WIDTH) box.vx = -box.vx;
+            if (box.bounds.y < 0.0f || box.bounds.y + box.bounds.height > FIELD_HEIGHT) box.vy = -box.vy;
+        }
+
+        // Churn: remove some bodies and bring back ones removed earlier
+        for (int k = 0; k < bodies / 100; k++) {
+            Box& box = boxes[nextRandom(rng) % bodies];
+            if (box.handle >= 0) {
+                broadphase.remove(box.handle);
+                box.handle = -1;
+            } else {
+                box.handle = broadphase.add(box.bounds, box.category, box.mask, 0);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (const Box& box : boxes) {
+            if (box.handle >= 0) {
+                broadphase.update(box.handle, box.bounds);
+            }
+        }
+        sapPairs = broadphase.findPairs();
+        sapSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        swaps += broadphase.getLastSortSwaps();
+
+        start = std::chrono::steady_clock::now();
+        bruteForce(boxes, brutePairs);
+        bruteSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        sortPairs(sapPairs);
+        sortPairs(brutePairs);
+        mismatches += samePairs(sapPairs, brutePairs) ? 0 : 1;
+        pairCount += static_cast<long long>(brutePairs.size());
+    }
+
+    std::printf("%d bodies, %d frames, %.1f pairs/frame\n", bodies, frames, static_cast<double>(pairCount) / frames);
+    std::printf("sweep and prune %8.3f ms/frame (%.0f swaps/frame)\n", sapSeconds * 1000.0 / frames,
+                static_cast<double>(swaps) / frames);
+    std::printf("brute force     %8.3f ms/frame\n", bruteSeconds * 1000.0 / frames);
+    std::printf("speedup %.1fx, %d frames with different pairs\n", bruteSeconds / sapSeconds, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
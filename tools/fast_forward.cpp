@@ -0,0 +1,162 @@
+// Headless fast-forward check and benchmark (native).
+//
+// Each session is first played the way a BREAKOUT_FIXED_POINT build plays
+// the game: FixedSimulation::step once per frame, with a FixedTrackingBot on
+// the paddle whose input is recorded frame by frame. The recording is then
+// replayed through the event-driven FixedSimulation::fastForward over the
+// whole session, with nothing resynchronised between the two. The state
+// hash after every event frame and at the end must equal the stepped
+// session's. Each side is then run again without hashing, the stepped one
+// with a plain FixedTrackingBot, and those runs are timed to report how
+// much faster than real time each advances.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/fast_forward.cpp src/fixed_simulation.cpp -o fast_forward
+//   ./fast_forward [sessions] [minutes per session]
+
+#include "../include/fixed_simulation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr int STEPS_PER_SECOND = 60;
+
+    class RecordingBot : public FixedPaddleController {
+    public:
+        explicit RecordingBot(uint32_t seed) : bot(seed) {}
+        void onEvent(const FixedSimulation& simulation) override { bot.onEvent(simulation); }
+        int axis(uint32_t frame, Fixed paddleX) override {
+            const int value = bot.axis(frame, paddleX);
+            if (axes.size() <= frame) {
+                axes.resize(frame + 1, 0);
+            }
+            axes[frame] = static_cast<int8_t>(value);
+            return value;
+        }
+
+        FixedTrackingBot bot;
+        std::vector<int8_t> axes;
+    };
+
+    class Replay : public FixedPaddleController {
+    public:
+        explicit Replay(const std::vector<int8_t>& axes) : axes(axes) {}
+        int axis(uint32_t frame, Fixed) override { return frame < axes.size() ? axes[frame] : 0; }
+
+    private:
+        const std::vector<int8_t>& axes;
+    };
+
+    struct EventState {
+        uint32_t frame;
+        uint64_t hash;
+    };
+
+    struct RunResult {
+        std::vector<EventState> events;
+        uint64_t hash;
+        uint32_t frames;
+        int score;
+        double seconds;
+    };
+
+    template <typename Advance>
+    RunResult play(GameMode mode, uint32_t seed, uint32_t maxFrames, FixedPaddleController& controller,
+                   bool hashEvents, Advance advance) {
+        FixedSimulation simulation(mode, STEPS_PER_SECOND, seed);
+        controller.onEvent(simulation);
+        RunResult result{};
+
+        auto start = std::chrono::steady_clock::now();
+        while (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+            if (advance(simulation, controller, maxFrames) != 0 && hashEvents) {
+                result.events.push_back(EventState{simulation.getFrame(), simulation.stateHash()});
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        result.hash = simulation.stateHash();
+        result.frames = simulation.getFrame();
+        result.score = simulation.getScore();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        return result;
+    }
+
+    // First event frame where the two runs differ, or UINT32_MAX
+    uint32_t firstDifference(const RunResult& stepped, const RunResult& fast) {
+        for (size_t i = 0; i < stepped.events.size(); i++) {
+            if (i >= fast.events.size() || fast.events[i].frame != stepped.events[i].frame ||
+                fast.events[i].hash != stepped.events[i].hash) {
+                return stepped.events[i].frame;
+            }
+        }
+        if (fast.events.size() != stepped.events.size() || fast.hash != stepped.hash ||
+            fast.frames != stepped.frames) {
+            return std::min(fast.frames, stepped.frames);
+        }
+        return UINT32_MAX;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int sessions = argc > 1 ? std::atoi(argv[1]) : 20;
+    const float minutes = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 10.0f;
+    const uint32_t maxFrames = static_cast<uint32_t>(minutes * 60.0f * STEPS_PER_SECOND);
+
+    const struct { GameMode mode; const char* name; } modes[] = {
+        { GameMode::CLASSIC, "Classic" },
+        { GameMode::MEGA_GRID, "Mega Grid" },
+        { GameMode::CHAOS, "Chaos" }
+    };
+
+    int mismatches = 0;
+    std::printf("%-10s %8s %12s %10s %10s %14s %14s %8s\n",
+                "mode", "sessions", "game time", "avg score", "events", "stepped", "fast-forward", "match");
+    for (const auto& entry : modes) {
+        double gameSeconds = 0.0, steppedSeconds = 0.0, fastSeconds = 0.0;
+        long long totalScore = 0;
+        size_t totalEvents = 0;
+        int matched = 0;
+
+        for (int session = 1; session <= sessions; session++) {
+            const uint32_t seed = static_cast<uint32_t>(session) * 2654435761u;
+            auto stepEach = [](FixedSimulation& sim, FixedPaddleController& controller, uint32_t) {
+                return sim.step(controller);
+            };
+            auto fastForward = [](FixedSimulation& sim, FixedPaddleController& controller, uint32_t limit) {
+                return sim.fastForward(controller, limit - sim.getFrame());
+            };
+            RecordingBot recorder(seed);
+            const RunResult stepped = play(entry.mode, seed, maxFrames, recorder, true, stepEach);
+            Replay replay(recorder.axes);
+            const RunResult fast = play(entry.mode, seed, maxFrames, replay, true, fastForward);
+
+            FixedTrackingBot bot(seed);
+            steppedSeconds += play(entry.mode, seed, maxFrames, bot, false, stepEach).seconds;
+            fastSeconds += play(entry.mode, seed, maxFrames, replay, false, fastForward).seconds;
+
+            const uint32_t difference = firstDifference(stepped, fast);
+            if (difference == UINT32_MAX) {
+                matched++;
+            } else {
+                mismatches++;
+                std::printf("  mismatch: %s seed %u from frame %u: stepped frame %u score %d, "
+                            "fast-forward frame %u score %d\n", entry.name, seed, difference, stepped.frames,
+                            stepped.score, fast.frames, fast.score);
+            }
+            gameSeconds += static_cast<double>(stepped.frames) / STEPS_PER_SECOND;
+            totalScore += stepped.score;
+            totalEvents += stepped.events.size();
+        }
+
+        std::printf("%-10s %8d %10.0f s %10lld %10zu %12.0fx %12.0fx %5d/%d\n",
+                    entry.name, sessions, gameSeconds, totalScore / sessions, totalEvents,
+                    gameSeconds / steppedSeconds, gameSeconds / fastSeconds, matched, sessions);
+    }
+    std::printf("stepped: FixedSimulation::step every frame, as the game runs it; fast-forward: the recorded\n"
+                "input replayed through fastForward; match: same state after every event and at the end\n");
+    return mismatches == 0 ? 0 : 1;
+}
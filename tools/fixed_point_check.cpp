@@ -0,0 +1,210 @@
+// Fixed-point determinism check and benchmark (native).
+//
+// Plays bot-driven FixedSimulation sessions for every mode and folds the
+// final state hashes into one digest per mode. The digests must equal the
+// reference values below on every compiler, flag set and target; a build
+// that disagrees has broken bit-exact replays.
+//
+// For cost, the same bot also plays two float versions; only their average
+// scores are shown, since their trajectories may differ between targets:
+//   systems  the interactive game's per-frame step, as Game::updatePlaying
+//            runs it: movementSystem, containmentSystem, the broadphase and
+//            the systems.h collision response on a World
+//   closed   Simulation::step, which places the ball in closed form
+// Times are nanoseconds per simulated frame.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/fixed_point_check.cpp src/fixed_simulation.cpp src/simulation.cpp
+//       src/systems.cpp src/broadphase.cpp -o fixed_point_check
+//   ./fixed_point_check [sessions] [minutes per session]
+//
+// The reference digests are for the default 20 sessions of 10 minutes.
+
+#include "../include/fixed_simulation.h"
+#include "../include/simulation.h"
+#include "systems_step.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    constexpr int STEPS_PER_SECOND = 60;
+    constexpr int DEFAULT_SESSIONS = 20;
+    constexpr float DEFAULT_MINUTES = 10.0f;
+
+    struct ModeEntry {
+        GameMode mode;
+        const char* name;
+        uint64_t reference;
+    };
+
+    const ModeEntry MODES[] = {
+        { GameMode::CLASSIC, "Classic", 0xfe23358cfba9c5daull },
+        { GameMode::MEGA_GRID, "Mega Grid", 0x5a75a13e366322c8ull },
+        { GameMode::CHAOS, "Chaos", 0xca9c7d3a7c2fa41dull }
+    };
+
+    uint32_t nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Follows the ball with the paddle centre, aiming off centre by an amount
+    // re-rolled on every paddle hit so rallies vary. Integer-only input, so
+    // the fixed runs stay exact.
+    class FollowBot {
+    public:
+        explicit FollowBot(uint32_t seed) : rng(seed != 0 ? seed : 1), offset(0) {}
+
+        int axis(int ballX, int paddleCentre) const {
+            int difference = ballX - offset - paddleCentre;
+            if (difference > DEAD_ZONE) return 1;
+            if (difference < -DEAD_ZONE) return -1;
+            return 0;
+        }
+
+        void onPaddleHit() { offset = static_cast<int>(nextRandom(rng) % 71) - 35; }
+
+    private:
+        static constexpr int DEAD_ZONE = 8;
+
+        uint32_t rng;
+        int offset;
+    };
+
+    class FloatFollowBot : public PaddleController {
+    public:
+        FloatFollowBot(const Simulation& simulation, uint32_t seed) : simulation(simulation), bot(seed) {}
+
+        float axis(uint32_t, float paddleX) override {
+            const float paddleWidth = simulation.getPaddleRect().width;
+            return static_cast<float>(bot.axis(static_cast<int>(simulation.getBallPosition().x),
+                                               static_cast<int>(paddleX + paddleWidth / 2)));
+        }
+
+        FollowBot& getBot() { return bot; }
+
+    private:
+        const Simulation& simulation;
+        FollowBot bot;
+    };
+
+    uint64_t combine(uint64_t digest, uint64_t hash) {
+        return (digest ^ hash) * 1099511628211ull;
+    }
+
+    struct ModeResult {
+        uint64_t digest;
+        uint64_t frames;
+        long long score;
+        double seconds;
+    };
+
+    ModeResult runFixed(GameMode mode, int sessions, uint32_t maxFrames) {
+        ModeResult result{14695981039346656037ull, 0, 0, 0.0};
+        auto start = std::chrono::steady_clock::now();
+        for (int session = 1; session <= sessions; session++) {
+            uint32_t seed = static_cast<uint32_t>(session) * 2654435761u;
+            FixedSimulation simulation(mode, STEPS_PER_SECOND, seed);
+            FollowBot bot(seed);
+            while (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+                const Fixed paddleCentre = simulation.getPaddleX() + simulation.getPaddleWidth().half();
+                const int axis = bot.axis(simulation.getBallPosition().x.raw >> Fixed::FRACTION_BITS,
+                                          paddleCentre.raw >> Fixed::FRACTION_BITS);
+                if (simulation.step(axis) & SIM_EVENT_PADDLE) {
+                    bot.onPaddleHit();
+                }
+            }
+            result.digest = combine(result.digest, simulation.stateHash());
+            result.frames += simulation.getFrame();
+            result.score += simulation.getScore();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    template <typename Config>
+    ModeResult runSystems(int sessions, uint32_t maxFrames) {
+        ModeResult result{14695981039346656037ull, 0, 0, 0.0};
+        auto start = std::chrono::steady_clock::now();
+        for (int session = 1; session <= sessions; session++) {
+            uint32_t seed = static_cast<uint32_t>(session) * 2654435761u;
+            SystemsStep<Config> game(seed);
+            FollowBot bot(seed);
+            while (!game.isOver() && game.getFrame() < maxFrames) {
+                const int axis = bot.axis(static_cast<int>(game.getBallX()), static_cast<int>(game.getPaddleCentre()));
+                if (game.step(static_cast<float>(axis))) {
+                    bot.onPaddleHit();
+                }
+            }
+            result.digest = combine(result.digest, game.stateHash());
+            result.frames += game.getFrame();
+            result.score += game.getScore();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    ModeResult runSystems(GameMode mode, int sessions, uint32_t maxFrames) {
+        switch (mode) {
+            case GameMode::MEGA_GRID: return runSystems<MegaGridConfig>(sessions, maxFrames);
+            case GameMode::CHAOS:     return runSystems<ChaosConfig>(sessions, maxFrames);
+            default:                  return runSystems<ClassicConfig>(sessions, maxFrames);
+        }
+    }
+
+    ModeResult runFloat(GameMode mode, int sessions, uint32_t maxFrames) {
+        ModeResult result{14695981039346656037ull, 0, 0, 0.0};
+        auto start = std::chrono::steady_clock::now();
+        for (int session = 1; session <= sessions; session++) {
+            uint32_t seed = static_cast<uint32_t>(session) * 2654435761u;
+            Simulation simulation(mode, 1.0f / STEPS_PER_SECOND, seed);
+            FloatFollowBot bot(simulation, seed);
+            while (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+                if (simulation.step(bot) & SIM_EVENT_PADDLE) {
+                    bot.getBot().onPaddleHit();
+                }
+            }
+            result.digest = combine(result.digest, simulation.stateHash());
+            result.frames += simulation.getFrame();
+            result.score += simulation.getScore();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int sessions = argc > 1 ? std::atoi(argv[1]) : DEFAULT_SESSIONS;
+    const float minutes = argc > 2 ? static_cast<float>(std::atof(argv[2])) : DEFAULT_MINUTES;
+    const uint32_t maxFrames = static_cast<uint32_t>(minutes * 60.0f * STEPS_PER_SECOND);
+    const bool checkReference = sessions == DEFAULT_SESSIONS && minutes == DEFAULT_MINUTES;
+
+    int mismatches = 0;
+    std::printf("%-10s %16s %6s %10s %10s %10s %10s %10s %10s\n", "mode", "fixed digest", "match", "avg score",
+                "fixed ns", "sys score", "sys ns", "closed sc", "closed ns");
+    for (const ModeEntry& entry : MODES) {
+        ModeResult fixed = runFixed(entry.mode, sessions, maxFrames);
+        ModeResult systems = runSystems(entry.mode, sessions, maxFrames);
+        ModeResult closed = runFloat(entry.mode, sessions, maxFrames);
+
+        const char* match = "-";
+        if (checkReference) {
+            match = fixed.digest == entry.reference ? "yes" : "NO";
+            if (fixed.digest != entry.reference) {
+                mismatches++;
+            }
+        }
+
+        std::printf("%-10s %016llx %6s %10lld %10.1f %10lld %10.1f %10lld %10.1f\n",
+                    entry.name, static_cast<unsigned long long>(fixed.digest), match,
+                    fixed.score / sessions, fixed.seconds * 1e9 / fixed.frames,
+                    systems.score / sessions, systems.seconds * 1e9 / systems.frames,
+                    closed.score / sessions, closed.seconds * 1e9 / closed.frames);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
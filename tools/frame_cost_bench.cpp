@@ -0,0 +1,404 @@
+// Update + draw cost per frame, ECS storage against the old object layout
+// (native).
+//
+// Builds the same mixed population both ways (60% bricks, 30% balls, 10%
+// paddles by default):
+//   objects  Paddle, Ball and Brick classes as they were before the ECS:
+//            private scalar fields, update()/draw() defined out of line, one
+//            unique_ptr per object, allocated in shuffled order so the heap
+//            objects are scattered the way a session's allocations leave them
+//   ECS      a World, updated by paddleInputSystem + movementSystem +
+//            containmentSystem and drawn by renderSystem into a
+//            RenderCommandBuffer that is then sorted and submitted
+//
+// Both draw through the same raylib entry points (DrawRectangle, DrawCircle),
+// stubbed out here to sum their arguments, so what's measured is the CPU side
+// of a frame up to the rlgl batcher, which costs the same for both. The
+// objects draw immediately, as they did; the ECS path includes recording,
+// sorting and replaying its commands. A third row skips the bricks on frames
+// where they didn't change, the way Game caches its brick layer. Update and
+// draw are timed separately. Both layouts must make the same draw calls and
+// end on the same positions.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/frame_cost_bench.cpp src/systems.cpp src/render_system.cpp src/render_commands.cpp
+//       -o frame_cost_bench
+//   ./frame_cost_bench [entities] [frames]
+
+#include "../include/systems.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Stand-ins for the raylib calls a frame makes. They count calls and sum their
+// arguments, so both layouts are charged the same per draw.
+namespace {
+    volatile double drawSink = 0.0;
+    long long drawCalls = 0;
+}
+
+extern "C" {
+    void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+        drawCalls++;
+        drawSink = drawSink + posX + posY + width + height + color.r;
+    }
+    void DrawCircle(int centerX, int centerY, float radius, Color color) {
+        drawCalls++;
+        drawSink = drawSink + centerX + centerY + radius + color.r;
+    }
+    void DrawText(const char*, int, int, int, Color) { drawCalls++; }
+    void DrawTexturePro(Texture2D, Rectangle, Rectangle, Vector2, float, Color) { drawCalls++; }
+}
+
+namespace {
+    constexpr float STEP = 1.0f / 60.0f;
+    constexpr float WIDTH = 800.0f;
+    constexpr float HEIGHT = 600.0f;
+
+    // The object layout, as before the ECS. Methods were defined in game.cpp
+    // and called from another translation unit, so they aren't inlined here.
+    float widthScale = 1.0f;
+    float heightScale = 1.0f;
+
+    class Paddle {
+    public:
+        Paddle(float x, float y, float width, float height, float speed)
+            : x(x), y(y), width(width), height(height), baseSpeed(speed), baseWidth(width), baseHeight(height),
+              touchActive(false), lastTouchX(0.0f), touchEnabled(false) {}
+        [[gnu::noinline]] void update(float deltaTime, float axis);
+        [[gnu::noinline]] void draw();
+        float getX() const { return x; }
+
+    private:
+        float x;
+        float y;
+        float width;
+        float height;
+        float baseSpeed;
+        float baseWidth;
+        float baseHeight;
+        bool touchActive;
+        float lastTouchX;
+        bool touchEnabled;
+    };
+
+    class Ball {
+    public:
+        Ball(float x, float y, float radius, float speedX, float speedY)
+            : x(x), y(y), radius(radius), baseRadius(radius), baseSpeedX(speedX), baseSpeedY(speedY), spin(0.0f) {}
+        [[gnu::noinline]] void update(float deltaTime);
+        [[gnu::noinline]] void draw();
+        float getX() const { return x; }
+        float getY() const { return y; }
+
+    private:
+        void clampToScreen();
+        void applySpinDecay(float deltaTime);
+
+        float x;
+        float y;
+        float radius;
+        float baseRadius;
+        float baseSpeedX;
+        float baseSpeedY;
+        float spin;
+    };
+
+    class Brick {
+    public:
+        Brick(float x, float y, float width, float height, bool isAlive, Color color)
+            : x(x), y(y), width(width), height(height), alive(isAlive), color(color) {}
+        [[gnu::noinline]] void draw();
+
+    private:
+        float x;
+        float y;
+        float width;
+        float height;
+        bool alive;
+        Color color;
+    };
+
+    void Paddle::update(float deltaTime, float axis) {
+        x += axis * baseSpeed * widthScale * deltaTime;
+        x = std::max(0.0f, std::min(x, WIDTH - width));
+    }
+
+    void Paddle::draw() {
+        DrawRectangle(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height),
+                      BLUE);
+    }
+
+    void Ball::update(float deltaTime) {
+        float spinInfluence = spin * BallTuning::SPIN_INFLUENCE;
+        x += (baseSpeedX + baseSpeedX * spinInfluence) * widthScale * deltaTime;
+        y += baseSpeedY * heightScale * deltaTime;
+        applySpinDecay(deltaTime);
+        clampToScreen();
+    }
+
+    void Ball::applySpinDecay(float deltaTime) {
+        if (spin > 0.0f) {
+            spin = std::max(0.0f, spin - BallTuning::SPIN_DECAY * deltaTime);
+        } else if (spin < 0.0f) {
+            spin = std::min(0.0f, spin + BallTuning::SPIN_DECAY * deltaTime);
+        }
+    }
+
+    void Ball::clampToScreen() {
+        if (x - radius < 0) {
+            x = radius;
+            baseSpeedX = -baseSpeedX;
+        }
+        if (x + radius > WIDTH) {
+            x = WIDTH - radius;
+            baseSpeedX = -baseSpeedX;
+        }
+        if (y - radius < 0) {
+            y = radius;
+            baseSpeedY = -baseSpeedY;
+        }
+    }
+
+    void Ball::draw() {
+        DrawCircle(static_cast<int>(x), static_cast<int>(y), radius, WHITE);
+    }
+
+    void Brick::draw() {
+        if (alive) {
+            DrawRectangle(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width),
+                          static_cast<int>(height), color);
+        }
+    }
+
+    struct Objects {
+        std::vector<std::unique_ptr<Paddle>> paddles;
+        std::vector<std::unique_ptr<Ball>> balls;
+        std::vector<std::unique_ptr<Brick>> bricks;
+    };
+
+    uint32_t nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    float randomFloat(uint32_t& state, float low, float high) {
+        return low + (high - low) * static_cast<float>(nextRandom(state) % 65536) / 65536.0f;
+    }
+
+    enum class Kind { BRICK, BALL, PADDLE };
+
+    struct Spawn {
+        Kind kind;
+        float x;
+        float y;
+        float dirX;
+        float dirY;
+        float speed;
+    };
+
+    std::vector<Spawn> makeSpawns(int count) {
+        uint32_t rng = 2463534242u;
+        std::vector<Spawn> spawns(count);
+        for (int i = 0; i < count; i++) {
+            Spawn& spawn = spawns[i];
+            const int bucket = i % 10;
+            spawn.kind = bucket < 6 ? Kind::BRICK : (bucket < 9 ? Kind::BALL : Kind::PADDLE);
+            spawn.x = randomFloat(rng, 20.0f, WIDTH - 120.0f);
+            spawn.y = randomFloat(rng, 20.0f, HEIGHT - 40.0f);
+            const float angle = randomFloat(rng, 0.0f, 6.2831853f);
+            spawn.dirX = std::cos(angle);
+            spawn.dirY = std::sin(angle);
+            spawn.speed = randomFloat(rng, 200.0f, 500.0f);
+        }
+        return spawns;
+    }
+
+    Objects buildObjects(const std::vector<Spawn>& spawns) {
+        // Allocation order shuffled against iteration order
+        std::vector<int> order(spawns.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = static_cast<int>(i);
+        }
+        uint32_t rng = 88172645u;
+        for (size_t i = order.size(); i > 1; i--) {
+            std::swap(order[i - 1], order[nextRandom(rng) % i]);
+        }
+
+        std::vector<std::unique_ptr<Paddle>> paddles(spawns.size());
+        std::vector<std::unique_ptr<Ball>> balls(spawns.size());
+        std::vector<std::unique_ptr<Brick>> bricks(spawns.size());
+        for (int index : order) {
+            const Spawn& spawn = spawns[index];
+            switch (spawn.kind) {
+                case Kind::PADDLE:
+                    paddles[index] = std::make_unique<Paddle>(spawn.x, spawn.y, PaddleTuning::BASE_WIDTH,
+                                                              PaddleTuning::BASE_HEIGHT, spawn.speed);
+                    break;
+                case Kind::BALL:
+                    balls[index] = std::make_unique<Ball>(spawn.x, spawn.y, BallTuning::BASE_RADIUS,
+                                                          spawn.dirX * spawn.speed, spawn.dirY * spawn.speed);
+                    break;
+                case Kind::BRICK:
+                    bricks[index] = std::make_unique<Brick>(spawn.x, spawn.y, 70.0f, 20.0f, true, RED);
+                    break;
+            }
+        }
+
+        Objects objects;
+        for (size_t i = 0; i < spawns.size(); i++) {
+            if (paddles[i]) objects.paddles.push_back(std::move(paddles[i]));
+            if (balls[i]) objects.balls.push_back(std::move(balls[i]));
+            if (bricks[i]) objects.bricks.push_back(std::move(bricks[i]));
+        }
+        return objects;
+    }
+
+    void buildWorld(World& world, const std::vector<Spawn>& spawns) {
+        for (size_t i = 0; i < spawns.size(); i++) {
+            const Spawn& spawn = spawns[i];
+            switch (spawn.kind) {
+                case Kind::PADDLE:
+                    world.create<PaddleArchetype>(
+                        Position{spawn.x, spawn.y}, Velocity{0.0f, 0.0f, spawn.speed, 0.0f},
+                        Collider{ColliderShape::BOX, PaddleTuning::BASE_WIDTH, PaddleTuning::BASE_HEIGHT, 0.0f,
+                                 PaddleTuning::BASE_WIDTH, PaddleTuning::BASE_HEIGHT, 0.0f, -1},
+                        Render{BLUE, RenderLayer::DYNAMIC}, PaddleTag{});
+                    break;
+                case Kind::BALL:
+                    world.create<BallArchetype>(
+                        Position{spawn.x, spawn.y}, Velocity{spawn.dirX, spawn.dirY, spawn.speed, 0.0f},
+                        Collider{ColliderShape::CIRCLE, 0.0f, 0.0f, BallTuning::BASE_RADIUS, 0.0f, 0.0f,
+                                 BallTuning::BASE_RADIUS, -1},
+                        Render{WHITE, RenderLayer::DYNAMIC}, BallTag{});
+                    break;
+                case Kind::BRICK:
+                    world.create<BrickArchetype>(
+                        Position{spawn.x, spawn.y},
+                        Collider{ColliderShape::BOX, 70.0f, 20.0f, 0.0f, 70.0f, 20.0f, 0.0f, -1},
+                        Health{1, 10}, Render{RED, RenderLayer::BRICKS}, GridCell{static_cast<int>(i)});
+                    break;
+            }
+        }
+    }
+
+    // Paddles sweep left and right, changing direction every second
+    float axisAt(int frame) {
+        return (frame / 60) % 2 == 0 ? 1.0f : -1.0f;
+    }
+
+    struct FrameTime {
+        double update = 0.0;
+        double draw = 0.0;
+    };
+
+    double since(std::chrono::steady_clock::time_point& mark) {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - mark).count();
+        mark = now;
+        return seconds;
+    }
+
+    FrameTime runObjects(Objects& objects, int frames) {
+        FrameTime time;
+        auto mark = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            const float axis = axisAt(frame);
+            for (auto& paddle : objects.paddles) paddle->update(STEP, axis);
+            for (auto& ball : objects.balls) ball->update(STEP);
+            time.update += since(mark);
+            for (auto& brick : objects.bricks) brick->draw();
+            for (auto& paddle : objects.paddles) paddle->draw();
+            for (auto& ball : objects.balls) ball->draw();
+            time.draw += since(mark);
+        }
+        return time;
+    }
+
+    FrameTime runWorld(World& world, int frames, bool cacheBricks) {
+        const Playfield playfield{WIDTH, HEIGHT, 1.0f, 1.0f};
+        RenderCommandBuffer commands;
+        FrameTime time;
+        auto mark = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            paddleInputSystem(world, PaddleInput{axisAt(frame), 0.0f});
+            movementSystem(world, STEP, playfield);
+            containmentSystem(world, playfield);
+            time.update += since(mark);
+
+            commands.clear();
+            // Nothing destroys bricks here, so a cached layer is drawn once
+            if (!cacheBricks || frame == 0) {
+                renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, commands);
+            }
+            renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, commands);
+            commands.sort();
+            commands.submit(nullptr);
+            time.draw += since(mark);
+        }
+        return time;
+    }
+
+    void printRow(const char* name, const FrameTime& time, const FrameTime& baseline, int frames) {
+        const double total = time.update + time.draw;
+        const double baseTotal = baseline.update + baseline.draw;
+        std::printf("%-30s %9.3f %9.3f %9.3f %7.1fx\n", name, time.update * 1000.0 / frames,
+                    time.draw * 1000.0 / frames, total * 1000.0 / frames, baseTotal / total);
+    }
+
+    // Largest position difference between the two layouts, matched by spawn order
+    float compareBalls(const Objects& objects, const World& world) {
+        const std::vector<Position>& positions = world.archetype<BallArchetype>().column<Position>();
+        float worst = 0.0f;
+        for (size_t i = 0; i < objects.balls.size(); i++) {
+            worst = std::max({worst, std::fabs(objects.balls[i]->getX() - positions[i].x),
+                              std::fabs(objects.balls[i]->getY() - positions[i].y)});
+        }
+        const std::vector<Position>& paddles = world.archetype<PaddleArchetype>().column<Position>();
+        for (size_t i = 0; i < objects.paddles.size(); i++) {
+            worst = std::max(worst, std::fabs(objects.paddles[i]->getX() - paddles[i].x));
+        }
+        return worst;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int entities = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+
+    const std::vector<Spawn> spawns = makeSpawns(entities);
+    Objects objects = buildObjects(spawns);
+    World world;
+    World cachedWorld;
+    buildWorld(world, spawns);
+    buildWorld(cachedWorld, spawns);
+
+    drawCalls = 0;
+    const FrameTime objectTime = runObjects(objects, frames);
+    const long long objectCalls = drawCalls;
+    drawCalls = 0;
+    const FrameTime worldTime = runWorld(world, frames, false);
+    const long long worldCalls = drawCalls;
+    drawCalls = 0;
+    const FrameTime cachedTime = runWorld(cachedWorld, frames, true);
+
+    const float difference = compareBalls(objects, world);
+    const bool ok = difference < 1e-3f && objectCalls == worldCalls;
+
+    std::printf("%d entities (%zu bricks, %zu balls, %zu paddles), %d frames\n", entities, objects.bricks.size(),
+                objects.balls.size(), objects.paddles.size(), frames);
+    std::printf("%-30s %9s %9s %9s %8s\n", "ms per frame", "update", "draw", "total", "speedup");
+    printRow("unique_ptr objects", objectTime, objectTime, frames);
+    printRow("ECS systems + command buffer", worldTime, objectTime, frames);
+    printRow("ECS, brick layer cached", cachedTime, objectTime, frames);
+    std::printf("draw calls %lld vs %lld, max position difference %.1e: %s\n", objectCalls, worldCalls,
+                difference, ok ? "ok" : "DIFF");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// CPU used by the paused game, drawing every frame (as before idle frames
+// were skipped) against sleeping between input polls (native, Linux with
+// Mesa, no window or display needed).
+//
+// The paused frame is the scene from raster_reference_scene.h at 800x600:
+// renderSystem records the bricks, paddle and ball, and the commands are
+// submitted through raylib's rlgl (rlgl_headless.h) into a framebuffer and
+// finished, paced to 60 Hz. The idle side sleeps for Game::IDLE_TICK and
+// does nothing else; skipped frames only poll input. CPU time is the whole
+// process's (getrusage), so llvmpipe's rasterizer threads are included; in a
+// browser that part lands on the GPU, while the compositor's own work for a
+// presented frame isn't counted here at all.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/idle_cpu_check.cpp src/render_commands.cpp src/render_system.cpp src/systems.cpp
+//       -lEGL -lGLESv2 -o idle_cpu_check
+//   ./idle_cpu_check [seconds per side]
+
+#include "rlgl_headless.h"
+#include "raster_reference_scene.h"
+#include "../include/render_commands.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double FRAME_SECONDS = 1.0 / 60.0;
+    constexpr double IDLE_TICK = 0.1;  // as Game::IDLE_TICK
+
+    double cpuSeconds() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+               (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    struct Result {
+        double cpuPercent;  // of one core
+        int ticks;
+    };
+
+    // Calls tick every period seconds for the given wall time
+    template <typename Tick>
+    Result measure(double seconds, double period, Tick tick) {
+        const Clock::time_point start = Clock::now();
+        const double cpuStart = cpuSeconds();
+        Clock::time_point next = start;
+        int ticks = 0;
+        while (std::chrono::duration<double>(Clock::now() - start).count() < seconds) {
+            tick();
+            ticks++;
+            next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+            std::this_thread::sleep_until(next);
+        }
+        const double wall = std::chrono::duration<double>(Clock::now() - start).count();
+        return Result{(cpuSeconds() - cpuStart) / wall * 100.0, ticks};
+    }
+}
+
+int main(int argc, char** argv) {
+    using namespace RasterReferenceScene;
+    const double seconds = argc > 1 ? std::max(1.0, std::atof(argv[1])) : 5.0;
+    if (!RlglHeadless::createContext()) {
+        std::fprintf(stderr, "no EGL/GLES2 context\n");
+        return 1;
+    }
+    const int width = static_cast<int>(WIDTH);
+    const int height = static_cast<int>(HEIGHT);
+    rlLoadExtensions(reinterpret_cast<void*>(eglGetProcAddress));
+    rlglInit(width, height);
+    const unsigned int framebuffer = rlLoadFramebuffer();
+    const unsigned int texture = rlLoadTexture(nullptr, width, height, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+    rlFramebufferAttach(framebuffer, texture, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    if (!rlFramebufferComplete(framebuffer)) {
+        std::fprintf(stderr, "framebuffer incomplete\n");
+        return 1;
+    }
+
+    World world;
+    build(world);
+    RenderCommandBuffer commands;
+    commands.reserve(256, 0);
+
+    // BeginDrawing, ClearBackground, the recorded frame, EndDrawing's flush
+    const Result drawn = measure(seconds, FRAME_SECONDS, [&] {
+        commands.clear();
+        renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, commands);
+        renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, commands);
+        commands.sort();
+        rlEnableFramebuffer(framebuffer);
+        rlViewport(0, 0, width, height);
+        rlMatrixMode(RL_PROJECTION);
+        rlLoadIdentity();
+        rlOrtho(0, width, height, 0, 0.0f, 1.0f);
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+        rlClearColor(0, 0, 0, 255);
+        rlClearScreenBuffers();
+        commands.submit(nullptr);
+        rlDrawRenderBatchActive();
+        glFinish();
+        rlDisableFramebuffer();
+    });
+    const Result skipped = measure(seconds, IDLE_TICK, [] {});
+
+    std::printf("%-22s %10s %12s %14s\n", "paused", "ticks/s", "cpu % core", "cpu ms/tick");
+    std::printf("%-22s %10.1f %12.2f %14.3f\n", "every frame drawn", drawn.ticks / seconds, drawn.cpuPercent,
+                drawn.cpuPercent * 10.0 * seconds / drawn.ticks);
+    std::printf("%-22s %10.1f %12.2f %14.3f\n", "idle frames skipped", skipped.ticks / seconds, skipped.cpuPercent,
+                skipped.cpuPercent * 10.0 * seconds / skipped.ticks);
+    std::printf("%d commands a frame on %s\n", static_cast<int>(commands.size()),
+                reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    return 0;
+}
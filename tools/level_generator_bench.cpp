@@ -0,0 +1,68 @@
+// Endless level generator benchmark (native).
+//
+// Produces the first N endless levels of a seed with LevelQueue at several
+// worker counts and reports levels per second, how many candidates the bot
+// rejected, and a digest of the accepted levels. The digests must agree:
+// which candidate wins may not depend on thread count or timing.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/level_generator_bench.cpp src/level_generator.cpp src/simulation.cpp
+//       src/systems.cpp src/broadphase.cpp -o level_generator_bench
+//   ./level_generator_bench [levels] [seed]
+
+#include "../include/level_generator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+    uint64_t combine(uint64_t digest, const LevelDesign& level) {
+        auto mix = [&](uint32_t value) { digest = (digest ^ value) * 1099511628211ull; };
+        mix(level.seed);
+        mix(static_cast<uint32_t>(level.number));
+        for (uint8_t hitPoints : level.hitPoints) {
+            mix(hitPoints);
+        }
+        return digest;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int levels = argc > 1 ? std::atoi(argv[1]) : 30;
+    const uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 12345u;
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+    std::printf("%7s %8s %11s %10s %12s %10s %16s\n",
+                "workers", "levels", "candidates", "accepted", "levels/s", "avg bricks", "digest");
+    uint64_t firstDigest = 0;
+    bool mismatch = false;
+    for (int workers = 0; workers <= std::max(4, hardware); workers = workers == 0 ? 1 : workers * 2) {
+        LevelQueue queue(workers);
+        auto start = std::chrono::steady_clock::now();
+        queue.start(seed);
+
+        uint64_t digest = 14695981039346656037ull;
+        long long bricks = 0;
+        for (int i = 0; i < levels; i++) {
+            LevelDesign level = queue.take();
+            digest = combine(digest, level);
+            bricks += level.brickCount();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const LevelQueue::Stats stats = queue.getStats();
+
+        if (workers == 0) {
+            firstDigest = digest;
+        } else if (digest != firstDigest) {
+            mismatch = true;
+        }
+        std::printf("%7d %8d %11d %9.0f%% %12.1f %10lld %016llx%s\n",
+                    workers, levels, stats.candidates, 100.0 * stats.accepted / std::max(1, stats.candidates),
+                    levels / seconds, bricks / levels, static_cast<unsigned long long>(digest),
+                    digest == firstDigest ? "" : "  MISMATCH");
+    }
+    return mismatch ? 1 : 0;
+}
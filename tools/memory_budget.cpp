@@ -0,0 +1,188 @@
+// Heap budget check for the game's own allocations (native).
+//
+// Replays what a long session does to the heap outside of drawing: storage
+// reserved the way Game::reserveStorage does, then many rounds of every mode
+// started over (bricks respawned, paddle and ball respawned, broadphase
+// rebuilt), endless levels taken from a LevelQueue, telemetry and saves
+// opened and the spectator stream encoded. memory_tracker.cpp is linked in,
+// so allocations are charged to the same tags the in-game overlay shows.
+//
+// The first WARMUP_ROUNDS rounds fill the level queue, whose working set
+// grows until levels reach full difficulty. After that the check fails if
+// any tag but LEVELS grows, if the heap not seen by the tracker grows, or if
+// the total heap in use ever goes past the warm-up peak plus HEAP_SLACK
+// (levels in flight come and go). raylib's share and draw lists need a GL
+// context and show up only in the overlay (F3) and through getMemoryUsage()
+// in the browser.
+//
+// glibc's per-thread cache keeps freed small blocks that mallinfo still
+// counts as in use, which reads as untracked growth; the tool re-runs itself
+// with the cache turned off.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/memory_budget.cpp src/memory_tracker.cpp src/level_generator.cpp src/simulation.cpp
+//       src/systems.cpp src/broadphase.cpp src/spectator_stream.cpp src/telemetry.cpp
+//       src/save_store.cpp src/persistent_storage.cpp -o memory_budget
+//   ./memory_budget [rounds]
+
+#include "../include/broadphase.h"
+#include "../include/brick_field.h"
+#include "../include/level_generator.h"
+#include "../include/memory_tracker.h"
+#include "../include/save_store.h"
+#include "../include/spectator_stream.h"
+#include "../include/systems.h"
+#include "../include/telemetry.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifdef __GLIBC__
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr float WIDTH = 800.0f;
+    constexpr float HEIGHT = 600.0f;
+    constexpr int MAX_BRICKS = std::max({BrickField<ClassicConfig>::COUNT, BrickField<MegaGridConfig>::COUNT,
+                                         BrickField<ChaosConfig>::COUNT, BrickField<EndlessConfig>::COUNT});
+
+    struct Session {
+        World world;
+        SweepAndPrune broadphase;
+        Entity paddle = NULL_ENTITY;
+        Entity ball = NULL_ENTITY;
+        SpectatorEncoder encoder;
+        std::vector<uint8_t> message;
+    };
+
+    // As reserved by Game::reserveStorage
+    constexpr size_t SPECTATOR_MESSAGE_BYTES = 4096;
+
+    // One endless level is taken per round
+    constexpr int WARMUP_ROUNDS = LevelTuning::RAMP_LEVELS + LevelQueue::PREFETCH;
+    constexpr size_t HEAP_SLACK = 16 * 1024;
+    constexpr size_t UNTRACKED_SLACK = 1024;  // malloc rounding as block sizes shift
+
+    template <typename Config>
+    void startGame(Session& session, GameMode mode, const LevelDesign& level) {
+        const Playfield playfield{WIDTH, HEIGHT, 1.0f, 1.0f};
+        {
+            MemoryScope scope(MemoryTag::BRICKS);
+            session.world.destroyAll<BrickArchetype>();
+            if (mode == GameMode::ENDLESS) {
+                BrickField<Config>::spawn(session.world, WIDTH, HEIGHT, level);
+            } else {
+                BrickField<Config>::spawn(session.world, WIDTH, HEIGHT);
+            }
+            session.broadphase.clear();
+            session.world.each<Position, Collider, Health>([&](Entity entity, Position& position,
+                                                               Collider& collider, Health&) {
+                session.broadphase.add(boxBounds(position, collider), 1u, 0u, static_cast<int>(entity.index));
+            });
+        }
+        {
+            MemoryScope scope(MemoryTag::BALLS);
+            session.world.destroy(session.paddle);
+            session.world.destroy(session.ball);
+            session.paddle = spawnPaddle(session.world, playfield, Config::PADDLE_BASE_SPEED);
+            session.ball = spawnBall(session.world, playfield, Config::BALL_BASE_SPEED);
+        }
+
+        MemoryScope scope(MemoryTag::SPECTATOR);
+        SpectatorState state{};
+        state.mode = mode;
+        state.width = WIDTH;
+        state.height = HEIGHT;
+        captureSpectatorState(session.world, mode == GameMode::ENDLESS ? level.hitPoints : std::vector<uint8_t>(),
+                              state);
+        session.message.clear();
+        session.encoder.encode(state, session.message);
+    }
+
+    struct Snapshot {
+        MemoryTracker::Usage usage[MEMORY_TAG_COUNT];
+        size_t heap;
+    };
+
+    Snapshot snapshot() {
+        MemoryTracker::refresh();
+        Snapshot result{};
+        for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+            result.usage[tag] = MemoryTracker::getUsage(static_cast<MemoryTag>(tag));
+        }
+        result.heap = MemoryTracker::getHeapInUse();
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+#ifdef __GLIBC__
+    const char* tunables = std::getenv("GLIBC_TUNABLES");
+    if (!tunables || !std::strstr(tunables, "glibc.malloc.tcache_count=0")) {
+        setenv("GLIBC_TUNABLES", "glibc.malloc.tcache_count=0", 1);
+        execv("/proc/self/exe", argv);
+        std::fprintf(stderr, "could not re-run without the malloc cache; heap figures include cached blocks\n");
+    }
+#endif
+    const int rounds = argc > 1 ? std::max(WARMUP_ROUNDS + 1, std::atoi(argv[1])) : WARMUP_ROUNDS + 50;
+
+    Session session;
+    LevelQueue levels(0);
+    Telemetry telemetry("memory_budget.bktl");
+    SaveStore saves("memory_budget.bksv");
+    {
+        MemoryScope scope(MemoryTag::BRICKS);
+        session.world.archetype<BrickArchetype>().reserve(MAX_BRICKS);
+        session.broadphase.reserve(MAX_BRICKS + 2);
+    }
+    {
+        MemoryScope scope(MemoryTag::SPECTATOR);
+        session.message.reserve(SPECTATOR_MESSAGE_BYTES);
+    }
+    levels.start(1);
+
+    Snapshot warm{};
+    size_t warmHeapPeak = 0;
+    size_t heapPeak = 0;
+    for (int round = 0; round < rounds; round++) {
+        startGame<ClassicConfig>(session, GameMode::CLASSIC, LevelDesign{});
+        startGame<MegaGridConfig>(session, GameMode::MEGA_GRID, LevelDesign{});
+        startGame<ChaosConfig>(session, GameMode::CHAOS, LevelDesign{});
+        LevelDesign level = levels.take();
+        startGame<EndlessConfig>(session, GameMode::ENDLESS, level);
+
+        const Snapshot now = snapshot();
+        if (round < WARMUP_ROUNDS) {
+            warmHeapPeak = std::max(warmHeapPeak, now.heap);
+            warm = now;
+        } else {
+            heapPeak = std::max(heapPeak, now.heap);
+        }
+    }
+    const Snapshot last = snapshot();
+
+    bool failed = false;
+    std::printf("%-18s %12s %12s %12s\n", "tag", "warmed up", "last round", "peak");
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        const MemoryTag memoryTag = static_cast<MemoryTag>(tag);
+        const size_t before = warm.usage[tag].current;
+        const size_t after = last.usage[tag].current;
+        // Levels in flight vary and are bounded by the heap check below
+        const size_t allowed = memoryTag == MemoryTag::LEVELS ? SIZE_MAX
+                               : memoryTag == MemoryTag::RAYLIB ? before + UNTRACKED_SLACK : before;
+        const bool tagGrew = after > allowed;
+        failed |= tagGrew;
+        std::printf("%-18s %12zu %12zu %12zu%s\n", MemoryTracker::getName(memoryTag), before, after,
+                    last.usage[tag].peak, tagGrew ? "  GREW" : "");
+    }
+    const bool heapOver = heapPeak > warmHeapPeak + HEAP_SLACK;
+    failed |= heapOver;
+    std::printf("%-18s %12zu %12zu %12zu%s\n", "heap in use", warmHeapPeak, last.heap, heapPeak,
+                heapOver ? "  OVER" : "");
+    std::printf("%d rounds of 4 modes after %d to warm up: %s (heap peak %zu, limit %zu)\n", rounds - WARMUP_ROUNDS,
+                WARMUP_ROUNDS, failed ? "restarts grow the heap" : "no growth across restarts", heapPeak,
+                warmHeapPeak + HEAP_SLACK);
+    return failed ? 1 : 0;
+}
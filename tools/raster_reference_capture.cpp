@@ -0,0 +1,99 @@
+// Captures the raylib reference frame for software_raster_bench (native,
+// Linux with Mesa, no window or display needed).
+//
+// Draws the scene from raster_reference_scene.h the way the game's F4 check
+// does: renderSystem records it, RenderCommandBuffer::submit calls
+// DrawRectangle/DrawCircle, and the frame goes into a render texture at 0.8x
+// zoom (640x480), is read back and box-filtered to 160x120. Drawing goes
+// through raylib's own rlgl (rlgl_headless.h), which Mesa's llvmpipe
+// rasterizes with the same GL rules a browser's WebGL uses.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/raster_reference_capture.cpp src/render_commands.cpp src/render_system.cpp
+//       src/systems.cpp src/software_raster.cpp src/fixed_simulation.cpp src/memory_tracker.cpp
+//       -lEGL -lGLESv2 -o raster_reference_capture
+//   ./raster_reference_capture [output.ppm]
+// The output defaults to tools/reference/raylib_frame_160x120.ppm.
+
+#include "rlgl_headless.h"
+#include "raster_reference_scene.h"
+#include "../include/render_commands.h"
+#include "../include/software_raster.h"
+#include <cstdio>
+#include <vector>
+
+int main(int argc, char** argv) {
+    using namespace RasterReferenceScene;
+    const char* path = argc > 1 ? argv[1] : "tools/reference/raylib_frame_160x120.ppm";
+    if (!RlglHeadless::createContext()) {
+        std::fprintf(stderr, "no EGL/GLES2 context\n");
+        return 1;
+    }
+    const int width = static_cast<int>(WIDTH * CAPTURE_SCALE);
+    const int height = static_cast<int>(HEIGHT * CAPTURE_SCALE);
+    rlLoadExtensions(reinterpret_cast<void*>(eglGetProcAddress));
+    rlglInit(width, height);
+
+    // LoadRenderTexture, minus the depth attachment the scene doesn't use
+    const unsigned int framebuffer = rlLoadFramebuffer();
+    const unsigned int texture = rlLoadTexture(nullptr, width, height, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+    rlFramebufferAttach(framebuffer, texture, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    if (!rlFramebufferComplete(framebuffer)) {
+        std::fprintf(stderr, "framebuffer incomplete\n");
+        return 1;
+    }
+
+    World world;
+    build(world);
+    RenderCommandBuffer commands;
+    renderSystem(world, RenderLayer::BRICKS, DrawLayer::SCENE, commands);
+    renderSystem(world, RenderLayer::DYNAMIC, DrawLayer::SCENE, commands);
+
+    // BeginTextureMode, ClearBackground(BLACK), BeginMode2D with only a zoom
+    rlEnableFramebuffer(framebuffer);
+    rlViewport(0, 0, width, height);
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, width, height, 0, 0.0f, 1.0f);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+    rlClearColor(0, 0, 0, 255);
+    rlClearScreenBuffers();
+    rlScalef(CAPTURE_SCALE, CAPTURE_SCALE, 1.0f);
+    commands.submit(nullptr);
+    rlDrawRenderBatchActive();
+
+    std::vector<uint8_t> readback(static_cast<size_t>(width) * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, readback.data());
+    rlDisableFramebuffer();
+
+    // Bottom-up RGBA to the top-down RGB frame the game compares
+    std::vector<uint8_t> downsampled(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT * 4);
+    SoftwareRasterizer::downsample(readback.data(), width, height, 4, downsampled.data(), FRAME_WIDTH, FRAME_HEIGHT);
+    std::vector<uint8_t> frame(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT * 3);
+    for (int y = 0; y < FRAME_HEIGHT; y++) {
+        for (int x = 0; x < FRAME_WIDTH; x++) {
+            const uint8_t* source = &downsampled[(static_cast<size_t>(FRAME_HEIGHT - 1 - y) * FRAME_WIDTH + x) * 4];
+            uint8_t* target = &frame[(static_cast<size_t>(y) * FRAME_WIDTH + x) * 3];
+            target[0] = source[0];
+            target[1] = source[1];
+            target[2] = source[2];
+        }
+    }
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", FRAME_WIDTH, FRAME_HEIGHT);
+    const bool written = std::fwrite(frame.data(), 1, frame.size(), file) == frame.size();
+    if (std::fclose(file) != 0 || !written) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    std::printf("%s: %dx%d captured at %dx%d on %s\n", path, FRAME_WIDTH, FRAME_HEIGHT, width, height,
+                reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    return 0;
+}
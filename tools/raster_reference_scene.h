@@ -0,0 +1,41 @@
+#ifndef RASTER_REFERENCE_SCENE_H
+#define RASTER_REFERENCE_SCENE_H
+
+#include "../include/brick_field.h"
+#include "../include/systems.h"
+#include <vector>
+
+// The scene behind tools/reference/raylib_frame_160x120.ppm, shared by
+// raster_reference_capture (which draws it with raylib) and
+// software_raster_bench (which compares SoftwareRasterizer against it): the
+// Classic grid at 800x600 with every fifth brick gone, and the paddle and
+// ball off pixel centres.
+namespace RasterReferenceScene {
+    constexpr float WIDTH = 800.0f;
+    constexpr float HEIGHT = 600.0f;
+    constexpr int FRAME_WIDTH = 160;
+    constexpr int FRAME_HEIGHT = 120;
+    // The game's F4 readback for an 800x600 window: 4x the frame size
+    constexpr float CAPTURE_SCALE = 0.8f;
+
+    inline void build(World& world) {
+        const Playfield playfield{WIDTH, HEIGHT, 1.0f, 1.0f};
+        BrickField<ClassicConfig>::spawn(world, WIDTH, HEIGHT);
+        std::vector<Entity> removed;
+        world.each<GridCell>([&](Entity entity, GridCell& cell) {
+            if (cell.index % 5 == 2) {
+                removed.push_back(entity);
+            }
+        });
+        for (Entity brick : removed) {
+            world.destroy(brick);
+        }
+
+        const Entity paddle = spawnPaddle(world, playfield, ClassicConfig::PADDLE_BASE_SPEED);
+        world.get<Position>(paddle).x = 313.37f;
+        const Entity ball = spawnBall(world, playfield, ClassicConfig::BALL_BASE_SPEED);
+        world.get<Position>(ball) = Position{401.6f, 377.3f};
+    }
+}
+
+#endif // RASTER_REFERENCE_SCENE_H
@@ -0,0 +1,106 @@
+#ifndef RLGL_HEADLESS_H
+#define RLGL_HEADLESS_H
+
+// raylib drawing for native tools, without a window or display (Linux with
+// Mesa): an OpenGL ES 2 context on EGL's surfaceless platform, raylib's own
+// rlgl (the vendored rlgl.h, compiled for ES 2 like the web build), and the
+// raylib calls RenderCommandBuffer::submit makes. The vendored library is
+// wasm only, so DrawRectangle and DrawCircle below repeat raylib 5.x's
+// rshapes vertex submission: a textured quad per rectangle, and 36 segments
+// in 18 quads per circle. Text and textures aren't drawn.
+//
+// Include it first, before anything that includes raylib.h, in exactly one
+// file of the tool, and link with -lEGL -lGLESv2.
+
+// rlgl is C and assigns malloc's result without a cast in one place; this
+// allocator converts to whatever pointer it's assigned to
+#include <cstdlib>
+struct RlglAllocation {
+    void* pointer;
+    template <typename T>
+    operator T*() const { return static_cast<T*>(pointer); }
+};
+#define RL_MALLOC(size) (RlglAllocation{std::malloc(size)})
+
+#include <raylib.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cmath>
+
+#define GRAPHICS_API_OPENGL_ES2
+#define RLGL_IMPLEMENTATION
+#include <rlgl.h>
+
+// What the game's frame calls, on rlgl
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    const float x = static_cast<float>(posX);
+    const float y = static_cast<float>(posY);
+    const float right = x + static_cast<float>(width);
+    const float bottom = y + static_cast<float>(height);
+
+    rlSetTexture(rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(0.0f, 0.0f);
+    rlVertex2f(x, y);
+    rlTexCoord2f(0.0f, 1.0f);
+    rlVertex2f(x, bottom);
+    rlTexCoord2f(1.0f, 1.0f);
+    rlVertex2f(right, bottom);
+    rlTexCoord2f(1.0f, 0.0f);
+    rlVertex2f(right, y);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void DrawCircle(int centerX, int centerY, float radius, Color color) {
+    constexpr int SEGMENTS = 36;
+    constexpr float STEP = 360.0f / SEGMENTS;
+    const float cx = static_cast<float>(centerX);
+    const float cy = static_cast<float>(centerY);
+    auto vertex = [&](float angle) {
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(cx + cosf(DEG2RAD * angle) * radius, cy + sinf(DEG2RAD * angle) * radius);
+    };
+
+    rlSetTexture(rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    float angle = 0.0f;
+    for (int i = 0; i < SEGMENTS / 2; i++) {
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(cx, cy);
+        vertex(angle + STEP * 2.0f);
+        vertex(angle + STEP);
+        vertex(angle);
+        angle += STEP * 2.0f;
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// Not drawn
+void DrawText(const char*, int, int, int, Color) {}
+void DrawTexturePro(Texture2D, Rectangle, Rectangle, Vector2, float, Color) {}
+
+namespace RlglHeadless {
+    // Current on the calling thread; everything is drawn into framebuffer objects
+    inline bool createContext() {
+        auto getPlatformDisplay =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        EGLDisplay display = getPlatformDisplay
+            ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)
+            : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_ES_API)) {
+            return false;
+        }
+        // Everything is drawn into a framebuffer object, so no surface and
+        // no config (surfaceless Mesa offers no ES configs anyway)
+        const EGLint contextAttributes[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+        EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+        return context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+    }
+}
+
+#endif // RLGL_HEADLESS_H
@@ -0,0 +1,271 @@
+// Software rasterizer accuracy check and benchmark (native).
+//
+// Accuracy: renders states from random play with SoftwareRasterizer and with
+// a brute-force reference that point-samples the scene 64x64 times per
+// pixel, and reports the per-byte error. Against raylib, it renders the
+// scene from raster_reference_scene.h and compares it with the committed
+// capture tools/reference/raylib_frame_160x120.ppm (see
+// raster_reference_capture.cpp) at the game's F4 tolerance. The two differ
+// at edges: the game draws at whole-pixel positions (RenderCommandBuffer::
+// submit truncates them), which is about a third of the error, and raylib's
+// frame has 4x4 point samples per pixel where the rasterizer has exact
+// coverage, which is the rest.
+//
+// Benchmark: renders whole batches through breakout_env_render at 84x84 gray
+// and 160x120 RGB, alone and together with stepping, in frames per second.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/software_raster_bench.cpp src/software_raster.cpp src/breakout_env.cpp
+//       src/fixed_simulation.cpp src/systems.cpp -o software_raster_bench
+//   ./software_raster_bench [steps] [threads] [--write] [--reference frame.ppm]
+// --write saves one frame of each size as raster_gray.pgm and raster_rgb.ppm.
+
+#include "raster_reference_scene.h"
+#include "../include/breakout_env.h"
+#include "../include/brick_field.h"
+#include "../include/software_raster.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int REFERENCE_SAMPLES = 64;  // per axis
+    // raylib's frame has 4x4 point samples per pixel and whole-pixel
+    // positions, so edges differ from exact coverage by up to a few dozen
+    // levels: these bounds catch a wrong colour, layout or orientation
+    // (the capture is at mean 1.7, 94.8% within tolerance), not edge detail
+    constexpr double MAX_RAYLIB_MEAN_ERROR = 2.5;
+    constexpr double MIN_RAYLIB_WITHIN = 0.93;
+
+    struct Size {
+        int width;
+        int height;
+        int channels;
+    };
+
+    uint32_t nextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Topmost primitive per sample, averaged
+    std::vector<uint8_t> renderReference(const FixedSimulation& game, Size size) {
+        const float scaleX = game.getPlayfieldSize().x.toFloat() / size.width;
+        const float scaleY = game.getPlayfieldSize().y.toFloat() / size.height;
+        const FixedVector brick = game.getBrickSize();
+        const FixedVector origin = game.getBrickCorner(0);
+        const int cols = BrickLayout<ClassicConfig>::COLS;
+        const int rows = BrickLayout<ClassicConfig>::ROWS;
+        const float pitchX = (game.getBrickCorner(1).x - origin.x).toFloat();
+        const float pitchY = (game.getBrickCorner(cols).y - origin.y).toFloat();
+        const FixedVector ball = game.getBallPosition();
+        const float radius = game.getBallRadius().toFloat();
+        const float paddleX = game.getPaddleX().toFloat();
+        const float paddleY = game.getPaddleY().toFloat();
+
+        auto sample = [&](float x, float y) {
+            const float dx = x - ball.x.toFloat();
+            const float dy = y - ball.y.toFloat();
+            if (dx * dx + dy * dy <= radius * radius) {
+                return WHITE;
+            }
+            if (x >= paddleX && x < paddleX + game.getPaddleWidth().toFloat() &&
+                y >= paddleY && y < paddleY + game.getPaddleHeight().toFloat()) {
+                return BLUE;
+            }
+            // The cell under the sample, then its neighbours
+            const int row = static_cast<int>((y - origin.y.toFloat()) / pitchY);
+            const int col = static_cast<int>((x - origin.x.toFloat()) / pitchX);
+            for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); r++) {
+                for (int c = std::max(0, col - 1); c <= std::min(cols - 1, col + 1); c++) {
+                    const int i = r * cols + c;
+                    const FixedVector corner = game.getBrickCorner(i);
+                    if (game.isBrickAlive(i) && x >= corner.x.toFloat() && x < (corner.x + brick.x).toFloat() &&
+                        y >= corner.y.toFloat() && y < (corner.y + brick.y).toFloat()) {
+                        return BrickLayout<ClassicConfig>::CELLS[i].color;
+                    }
+                }
+            }
+            return BLACK;
+        };
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(size.width) * size.height * size.channels);
+        for (int py = 0; py < size.height; py++) {
+            for (int px = 0; px < size.width; px++) {
+                float r = 0.0f, g = 0.0f, b = 0.0f;
+                for (int sy = 0; sy < REFERENCE_SAMPLES; sy++) {
+                    for (int sx = 0; sx < REFERENCE_SAMPLES; sx++) {
+                        const Color color = sample((px + (sx + 0.5f) / REFERENCE_SAMPLES) * scaleX,
+                                                   (py + (sy + 0.5f) / REFERENCE_SAMPLES) * scaleY);
+                        r += color.r;
+                        g += color.g;
+                        b += color.b;
+                    }
+                }
+                const float samples = REFERENCE_SAMPLES * REFERENCE_SAMPLES;
+                uint8_t* out = pixels.data() + (static_cast<size_t>(py) * size.width + px) * size.channels;
+                if (size.channels == 1) {
+                    out[0] = static_cast<uint8_t>((77.0f * r + 150.0f * g + 29.0f * b) / (256.0f * samples) + 0.5f);
+                } else {
+                    out[0] = static_cast<uint8_t>(r / samples + 0.5f);
+                    out[1] = static_cast<uint8_t>(g / samples + 0.5f);
+                    out[2] = static_cast<uint8_t>(b / samples + 0.5f);
+                }
+            }
+        }
+        return pixels;
+    }
+
+    bool checkAccuracy(Size size) {
+        FixedSimulation game(GameMode::CLASSIC, 60, 7);
+        SoftwareRasterizer rasterizer(size.width, size.height, static_cast<SoftwareRasterizer::Format>(size.channels),
+                                      game.getPlayfieldSize().x.toFloat(), game.getPlayfieldSize().y.toFloat());
+        std::vector<uint8_t> pixels(rasterizer.getFrameSize());
+        uint32_t rng = 99;
+        double meanError = 0.0;
+        double within = 1.0;
+        int maxError = 0;
+        constexpr int STATES = 8;
+        for (int state = 0; state < STATES; state++) {
+            for (int frame = 0; frame < 600 && !game.isOver(); frame++) {
+                game.step(static_cast<int>(nextRandom(rng) % 3) - 1);
+            }
+            rasterizer.renderSimulation(game, pixels.data());
+            const std::vector<uint8_t> reference = renderReference(game, size);
+            const SoftwareRasterizer::Difference difference =
+                SoftwareRasterizer::compare(pixels.data(), reference.data(), pixels.size(), 4);
+            meanError += difference.meanError / STATES;
+            within = std::min(within, difference.withinTolerance);
+            maxError = std::max(maxError, difference.maxError);
+        }
+        const bool passed = meanError < 0.5 && within > 0.99;
+        std::printf("%4dx%-4d %5s  mean error %.3f  max %3d  worst frame %.2f%% within 4  %s\n", size.width,
+                    size.height, size.channels == 1 ? "gray" : "rgb", meanError, maxError, within * 100.0,
+                    passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    bool checkRaylibReference(const char* path) {
+        using namespace RasterReferenceScene;
+        constexpr int TOLERANCE = 8;  // Game::compareSoftwareRaster's
+
+        std::vector<uint8_t> reference(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT * 3);
+        FILE* file = std::fopen(path, "rb");
+        int width = 0;
+        int height = 0;
+        int maxValue = 0;
+        const bool read = file && std::fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) == 3 &&
+                          std::fgetc(file) != EOF && width == FRAME_WIDTH && height == FRAME_HEIGHT &&
+                          maxValue == 255 && std::fread(reference.data(), 1, reference.size(), file) == reference.size();
+        if (file) {
+            std::fclose(file);
+        }
+        if (!read) {
+            std::printf("raylib reference %s: missing or not a %dx%d P6 image  FAILED\n", path, FRAME_WIDTH,
+                        FRAME_HEIGHT);
+            return false;
+        }
+
+        World world;
+        build(world);
+        SoftwareRasterizer rasterizer(FRAME_WIDTH, FRAME_HEIGHT, SoftwareRasterizer::Format::RGB, WIDTH, HEIGHT);
+        std::vector<uint8_t> pixels(rasterizer.getFrameSize());
+        rasterizer.renderWorld(world, pixels.data());
+        const SoftwareRasterizer::Difference difference =
+            SoftwareRasterizer::compare(pixels.data(), reference.data(), pixels.size(), TOLERANCE);
+        const bool passed = difference.meanError < MAX_RAYLIB_MEAN_ERROR &&
+                            difference.withinTolerance > MIN_RAYLIB_WITHIN;
+        std::printf("%4dx%-4d %5s  mean error %.3f  max %3d  %.2f%% within %d of raylib  %s\n", FRAME_WIDTH,
+                    FRAME_HEIGHT, "rgb", difference.meanError, difference.maxError,
+                    difference.withinTolerance * 100.0, TOLERANCE, passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    void writeImage(const char* path, const std::vector<uint8_t>& pixels, Size size) {
+        FILE* file = std::fopen(path, "wb");
+        if (!file) {
+            return;
+        }
+        std::fprintf(file, "P%d\n%d %d\n255\n", size.channels == 1 ? 5 : 6, size.width, size.height);
+        std::fwrite(pixels.data(), 1, pixels.size(), file);
+        std::fclose(file);
+    }
+
+    void benchmark(Size size, int count, int threads, int steps, bool write) {
+        BreakoutEnvConfig config = breakout_env_default_config();
+        config.threads = threads;
+        BreakoutEnv* env = breakout_env_create(count, &config);
+        breakout_env_set_pixels(env, size.width, size.height, size.channels);
+
+        std::vector<int8_t> actions(count);
+        std::vector<float> rewards(count);
+        std::vector<uint8_t> dones(count);
+        std::vector<uint8_t> pixels(static_cast<size_t>(count) * size.width * size.height * size.channels);
+        breakout_env_reset(env, nullptr, nullptr);
+
+        uint32_t rng = 5;
+        double renderSeconds = 0.0;
+        double totalSeconds = 0.0;
+        for (int step = 0; step < steps; step++) {
+            for (int8_t& action : actions) {
+                action = static_cast<int8_t>(nextRandom(rng) % 3) - 1;
+            }
+            auto start = std::chrono::steady_clock::now();
+            breakout_env_step(env, actions.data(), nullptr, nullptr, rewards.data(), dones.data());
+            auto stepped = std::chrono::steady_clock::now();
+            breakout_env_render(env, pixels.data());
+            auto rendered = std::chrono::steady_clock::now();
+            renderSeconds += std::chrono::duration<double>(rendered - stepped).count();
+            totalSeconds += std::chrono::duration<double>(rendered - start).count();
+        }
+
+        const double frames = static_cast<double>(count) * steps;
+        std::printf("%4dx%-4d %5s %6d %7d %14.0f %14.0f %10.2f\n", size.width, size.height,
+                    size.channels == 1 ? "gray" : "rgb", count, breakout_env_thread_count(env),
+                    frames / renderSeconds, frames / totalSeconds, renderSeconds * 1e9 / frames);
+
+        if (write) {
+            const std::vector<uint8_t> first(pixels.begin(), pixels.begin() + pixels.size() / count);
+            writeImage(size.channels == 1 ? "raster_gray.pgm" : "raster_rgb.ppm", first, size);
+        }
+        breakout_env_destroy(env);
+    }
+}
+
+int main(int argc, char** argv) {
+    bool write = false;
+    const char* referencePath = "tools/reference/raylib_frame_160x120.ppm";
+    std::vector<int> numbers;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--write") == 0) {
+            write = true;
+        } else if (std::strcmp(argv[i], "--reference") == 0 && i + 1 < argc) {
+            referencePath = argv[++i];
+        } else {
+            numbers.push_back(std::atoi(argv[i]));
+        }
+    }
+    const int steps = numbers.size() > 0 ? numbers[0] : 200;
+    const int threads = numbers.size() > 1 ? numbers[1] : static_cast<int>(std::thread::hardware_concurrency());
+    const Size sizes[] = { {84, 84, 1}, {160, 120, 3} };
+
+    bool passed = true;
+    for (const Size& size : sizes) {
+        passed &= checkAccuracy(size);
+    }
+    passed &= checkRaylibReference(referencePath);
+
+    std::printf("\n%9s %5s %6s %7s %14s %14s %10s\n", "size", "fmt", "envs", "threads", "render fps",
+                "step+render", "ns/frame");
+    for (const Size& size : sizes) {
+        benchmark(size, 1024, threads, steps, write);
+    }
+    return passed ? 0 : 1;
+}
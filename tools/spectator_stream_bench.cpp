@@ -0,0 +1,226 @@
+// Spectator stream check and benchmark (native, POSIX sockets).
+//
+// Records bot sessions on the headless Simulation, encodes every tick and
+// sends the framed stream through a TCP connection on 127.0.0.1 to a thread
+// that decodes it. Every decoded tick is checked against what was recorded:
+// positions within the 1/8 px quantization, bricks and HUD exact. A second
+// decoder joins each stream halfway through and must pick it up at the next
+// keyframe.
+//
+// Reports the stream's bytes per second at 60 ticks/s next to sending a full
+// snapshot every tick, average keyframe and delta sizes, and encode/decode
+// time per tick.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/spectator_stream_bench.cpp src/spectator_stream.cpp src/simulation.cpp
+//       src/systems.cpp src/broadphase.cpp -o spectator_stream_bench
+//   ./spectator_stream_bench [sessions] [minutes per session]
+
+#include "../include/simulation.h"
+#include "../include/spectator_stream.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr float STEP = 1.0f / 60.0f;
+    constexpr float TOLERANCE = 0.5f / 8.0f + 1e-3f;
+
+    struct Recording {
+        std::vector<SpectatorState> states;
+        size_t snapshotBytes;  // a full state sent raw
+    };
+
+    struct ReceiveResult {
+        size_t decoded;
+        size_t mismatches;
+        double seconds;
+    };
+
+    Recording record(GameMode mode, uint32_t seed, uint32_t maxFrames) {
+        Simulation simulation(mode, STEP, seed);
+        TrackingBot bot(seed);
+        bot.onEvent(simulation);
+
+        Recording recording;
+        const std::vector<uint8_t> fullGrid;
+        while (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+            simulation.step(bot);
+            SpectatorState state{};
+            state.tick = simulation.getFrame();
+            state.mode = mode;
+            state.phase = 1;
+            state.score = simulation.getScore();
+            state.lives = simulation.getLives();
+            state.width = simulation.getPlayfield().width;
+            state.height = simulation.getPlayfield().height;
+            captureSpectatorState(simulation.getWorld(), fullGrid, state);
+            recording.states.push_back(state);
+        }
+
+        const SpectatorState& first = recording.states.front();
+        recording.snapshotBytes = 4 + 2 + 3 * 4 + 2 * 4 + first.layout.size() + first.alive.size() * 8 + 4 * 4 +
+                                  2 * 4 + 4;
+        return recording;
+    }
+
+    bool matches(const SpectatorState& a, const SpectatorState& b) {
+        auto near = [](float x, float y) { return std::fabs(x - y) <= TOLERANCE; };
+        return a.tick == b.tick && a.score == b.score && a.lives == b.lives && a.phase == b.phase &&
+               a.alive == b.alive && a.layout == b.layout && near(a.ball.x, b.ball.x) && near(a.ball.y, b.ball.y) &&
+               near(a.paddle.x, b.paddle.x) && near(a.paddle.y, b.paddle.y) &&
+               near(a.paddle.width, b.paddle.width) && near(a.ballRadius, b.ballRadius);
+    }
+
+    ReceiveResult receive(int socket, const std::vector<SpectatorState>& expected) {
+        StreamFramer framer;
+        SpectatorDecoder decoder;
+        std::vector<uint8_t> message;
+        uint8_t chunk[16384];
+        ReceiveResult result{0, 0, 0.0};
+
+        while (result.decoded < expected.size()) {
+            const ssize_t received = recv(socket, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                break;
+            }
+            framer.feed(chunk, static_cast<size_t>(received));
+            while (framer.next(message)) {
+                auto start = std::chrono::steady_clock::now();
+                const bool ok = decoder.decode(message.data(), message.size());
+                result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (!ok || !matches(decoder.getState(), expected[result.decoded])) {
+                    result.mismatches++;
+                }
+                result.decoded++;
+            }
+        }
+        return result;
+    }
+
+    // A connected pair of TCP sockets on the loopback interface
+    bool connectLoopback(int& sender, int& receiver) {
+        const int listener = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener, 1) != 0 || getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            return false;
+        }
+        sender = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(sender, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return false;
+        }
+        receiver = accept(listener, nullptr, nullptr);
+        close(listener);
+        const int noDelay = 1;
+        setsockopt(sender, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        return receiver >= 0;
+    }
+
+    // Frames the late joiner waited for a keyframe; -1 if it never synced or
+    // went wrong afterwards
+    int lateJoin(const std::vector<std::vector<uint8_t>>& messages, const std::vector<SpectatorState>& states) {
+        SpectatorDecoder decoder;
+        const size_t joined = messages.size() / 2;
+        int waited = -1;
+        for (size_t i = joined; i < messages.size(); i++) {
+            const bool ok = decoder.decode(messages[i].data(), messages[i].size());
+            if (ok && waited < 0) {
+                waited = static_cast<int>(i - joined);
+            }
+            if (waited >= 0 && (!ok || !matches(decoder.getState(), states[i]))) {
+                return -1;
+            }
+        }
+        return waited;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int sessions = argc > 1 ? std::atoi(argv[1]) : 5;
+    const float minutes = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 3.0f;
+    const uint32_t maxFrames = static_cast<uint32_t>(minutes * 60.0f / STEP);
+
+    const struct { GameMode mode; const char* name; } modes[] = {
+        { GameMode::CLASSIC, "Classic" },
+        { GameMode::MEGA_GRID, "Mega Grid" },
+        { GameMode::CHAOS, "Chaos" }
+    };
+
+    bool failed = false;
+    std::printf("%-10s %8s %10s %10s %8s %8s %9s %9s %8s %6s\n", "mode", "ticks", "stream B/s", "full B/s",
+                "key B", "delta B", "enc ns", "dec ns", "join", "match");
+    for (const auto& entry : modes) {
+        size_t ticks = 0, bytes = 0, snapshotBytes = 0, keyframeBytes = 0, keyframes = 0, mismatches = 0;
+        double encodeSeconds = 0.0, decodeSeconds = 0.0;
+        int worstJoin = 0;
+
+        for (int session = 0; session < sessions; session++) {
+            const Recording recording = record(entry.mode, 1000 + session, maxFrames);
+            const std::vector<SpectatorState>& states = recording.states;
+
+            SpectatorEncoder encoder;
+            std::vector<std::vector<uint8_t>> messages(states.size());
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < states.size(); i++) {
+                encoder.encode(states[i], messages[i]);
+            }
+            encodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            for (const std::vector<uint8_t>& message : messages) {
+                if (message[0] == 'K') {
+                    keyframeBytes += message.size();
+                }
+            }
+
+            int sender = -1, receiver = -1;
+            if (!connectLoopback(sender, receiver)) {
+                std::printf("could not open a loopback TCP connection\n");
+                return 1;
+            }
+            ReceiveResult result{0, 0, 0.0};
+            std::thread reader([&] { result = receive(receiver, states); });
+            std::vector<uint8_t> framed;
+            for (const std::vector<uint8_t>& message : messages) {
+                framed.clear();
+                frameMessage(message, framed);
+                if (send(sender, framed.data(), framed.size(), 0) != static_cast<ssize_t>(framed.size())) {
+                    break;
+                }
+            }
+            reader.join();
+            close(sender);
+            close(receiver);
+
+            const int joinedAfter = lateJoin(messages, states);
+            worstJoin = joinedAfter < 0 || worstJoin < 0 ? -1 : std::max(worstJoin, joinedAfter);
+            mismatches += result.mismatches + (states.size() - result.decoded);
+            decodeSeconds += result.seconds;
+            ticks += states.size();
+            bytes += encoder.getBytes();
+            keyframes += encoder.getKeyframes();
+            snapshotBytes += recording.snapshotBytes * states.size();
+        }
+
+        const double seconds = ticks * STEP;
+        const bool ok = mismatches == 0 && worstJoin >= 0 && worstJoin <= static_cast<int>(SpectatorEncoder::KEYFRAME_INTERVAL);
+        failed |= !ok;
+        std::printf("%-10s %8zu %10.0f %10.0f %8.1f %8.2f %9.1f %9.1f %8d %6s\n", entry.name, ticks, bytes / seconds,
+                    snapshotBytes / seconds, static_cast<double>(keyframeBytes) / keyframes,
+                    static_cast<double>(bytes - keyframeBytes) / (ticks - keyframes), encodeSeconds * 1e9 / ticks,
+                    decodeSeconds * 1e9 / ticks, worstJoin, ok ? "yes" : "NO");
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+// How long Simulation's closed-form ball follows the game's per-frame
+// movement (native).
+//
+// Simulation::step and fastForward both place the ball with the same
+// closed-form segment formula; the interactive float game instead
+// accumulates position every frame in movementSystem. Replays of game
+// sessions therefore go through FixedSimulation (tools/fast_forward.cpp
+// checks those bit for bit); this tool reports how far the float
+// Simulation is from standing in for the game.
+//
+// Each session is first played by a TrackingBot on a Simulation and its
+// per-frame paddle inputs are recorded. The recording is then replayed, over
+// the whole session and with nothing resynchronised, into a fresh
+// Simulation and in lockstep into SystemsStep (systems_step.h), the game's
+// own per-frame systems on a World. Reported per mode: how many frames the
+// two balls stay within a tenth of a pixel, the largest drift before that,
+// and how many sessions still end on the same frame, score and lives. The
+// numbers are informational; nothing here is expected to match exactly.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Iinclude -Ivendor/raylib-emscripten/include
+//       tools/step_drift_check.cpp src/simulation.cpp src/systems.cpp src/broadphase.cpp -o step_drift_check
+//   ./step_drift_check [sessions] [minutes per session]
+
+#include "../include/simulation.h"
+#include "systems_step.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr float STEP = 1.0f / 60.0f;
+    // A tenth of a pixel at the 800x600 base resolution
+    constexpr float MAX_DRIFT = 0.1f;
+
+    class RecordingBot : public PaddleController {
+    public:
+        explicit RecordingBot(uint32_t seed) : bot(seed) {}
+        void onEvent(const Simulation& simulation) override { bot.onEvent(simulation); }
+        float axis(uint32_t frame, float paddleX) override {
+            const float value = bot.axis(frame, paddleX);
+            if (axes.size() <= frame) {
+                axes.resize(frame + 1, 0.0f);
+            }
+            axes[frame] = value;
+            return value;
+        }
+
+        TrackingBot bot;
+        std::vector<float> axes;
+    };
+
+    class Replay : public PaddleController {
+    public:
+        explicit Replay(const std::vector<float>& axes) : axes(axes) {}
+        float axis(uint32_t frame, float) override { return frame < axes.size() ? axes[frame] : 0.0f; }
+
+    private:
+        const std::vector<float>& axes;
+    };
+
+    struct SessionDrift {
+        uint32_t frames;     // the recorded session's length
+        uint32_t together;   // frames before the balls first drift apart
+        double before;       // largest ball drift before that
+        double paddle;       // largest paddle drift before that
+        bool sameOutcome;    // same end frame, score and lives
+    };
+
+    template <typename Config>
+    SessionDrift replay(GameMode mode, uint32_t seed, uint32_t maxFrames) {
+        RecordingBot recorder(seed);
+        {
+            Simulation simulation(mode, STEP, seed);
+            recorder.onEvent(simulation);
+            while (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+                simulation.step(recorder);
+            }
+        }
+
+        Simulation simulation(mode, STEP, seed);
+        SystemsStep<Config> game(seed);
+        Replay inputs(recorder.axes);
+        SessionDrift drift{0, 0, 0.0, 0.0, false};
+        bool apart = false;
+        while (!simulation.isOver() || !game.isOver()) {
+            if (simulation.getFrame() >= maxFrames && game.getFrame() >= maxFrames) {
+                break;
+            }
+            if (!simulation.isOver() && simulation.getFrame() < maxFrames) {
+                simulation.step(inputs);
+            }
+            if (!game.isOver() && game.getFrame() < maxFrames) {
+                game.step(inputs.axis(game.getFrame() + 1, 0.0f));
+            }
+            if (apart) {
+                continue;
+            }
+            const Vector2 expected = simulation.getBallPosition();
+            const Vector2 position = game.getBallPosition();
+            const double distance = std::hypot(static_cast<double>(position.x) - expected.x,
+                                               static_cast<double>(position.y) - expected.y);
+            if (distance >= MAX_DRIFT || simulation.getFrame() != game.getFrame()) {
+                apart = true;
+                continue;
+            }
+            drift.together = simulation.getFrame();
+            drift.before = std::max(drift.before, distance);
+            drift.paddle = std::max(drift.paddle, static_cast<double>(std::fabs(
+                game.getPaddleX() - simulation.getPaddleRect().x)));
+        }
+        drift.frames = simulation.getFrame();
+        drift.sameOutcome = simulation.getFrame() == game.getFrame() && simulation.getScore() == game.getScore() &&
+                            simulation.getLives() == game.getLives();
+        return drift;
+    }
+
+    SessionDrift replay(GameMode mode, uint32_t seed, uint32_t maxFrames) {
+        switch (mode) {
+            case GameMode::MEGA_GRID: return replay<MegaGridConfig>(mode, seed, maxFrames);
+            case GameMode::CHAOS:     return replay<ChaosConfig>(mode, seed, maxFrames);
+            default:                  return replay<ClassicConfig>(mode, seed, maxFrames);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const int sessions = argc > 1 ? std::atoi(argv[1]) : 20;
+    const float minutes = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 5.0f;
+    const uint32_t maxFrames = static_cast<uint32_t>(minutes * 60.0f / STEP);
+
+    const struct { GameMode mode; const char* name; } modes[] = {
+        { GameMode::CLASSIC, "Classic" },
+        { GameMode::MEGA_GRID, "Mega Grid" },
+        { GameMode::CHAOS, "Chaos" }
+    };
+
+    std::printf("%-10s %9s %10s %10s %10s %12s %11s %8s\n", "mode", "frames", "min apart", "mean apart",
+                "max apart", "max ball px", "max paddle", "same end");
+    for (const auto& entry : modes) {
+        uint64_t frames = 0, together = 0;
+        uint32_t shortest = UINT32_MAX, longest = 0;
+        double ball = 0.0, paddle = 0.0;
+        int sameOutcome = 0;
+        for (int session = 1; session <= sessions; session++) {
+            const SessionDrift drift = replay(entry.mode, static_cast<uint32_t>(session) * 2654435761u, maxFrames);
+            frames += drift.frames;
+            together += drift.together;
+            shortest = std::min(shortest, drift.together);
+            longest = std::max(longest, drift.together);
+            ball = std::max(ball, drift.before);
+            paddle = std::max(paddle, drift.paddle);
+            sameOutcome += drift.sameOutcome ? 1 : 0;
+        }
+        std::printf("%-10s %9llu %10u %10llu %10u %12.2e %11.2e %5d/%d\n", entry.name,
+                    static_cast<unsigned long long>(frames), shortest,
+                    static_cast<unsigned long long>(together / sessions), longest, ball, paddle, sameOutcome,
+                    sessions);
+    }
+    std::printf("apart: frame on which the two balls first differ by 0.1 px or more; max ball px, max paddle:\n"
+                "largest drift before that; same end: sessions ending on the same frame, score and lives\n");
+    return 0;
+}
@@ -0,0 +1,150 @@
+#ifndef SYSTEMS_STEP_H
+#define SYSTEMS_STEP_H
+
+#include "../include/simulation.h"
+#include <algorithm>
+#include <vector>
+
+// Game::updatePlaying for a launched ball at a fixed 60 Hz step, without the
+// window: input, movement, containment, speed-ups, broadphase, paddle and
+// brick response, life loss. Shared by fixed_point_check (its cost) and
+// step_drift_check (how soon Simulation's closed-form ball leaves it).
+template <typename Config>
+class SystemsStep {
+public:
+    explicit SystemsStep(uint32_t seed)
+        : playfield{800.0f, 600.0f, 1.0f, 1.0f}, rng(seed != 0 ? seed : 1), speedTimer(0.0f), frame(0),
+          score(0), lives(Simulation::INITIAL_LIVES) {
+        BrickField<Config>::spawn(world, playfield.width, playfield.height);
+        world.each<Position, Collider, Health>([this](Entity entity, Position& position, Collider& collider,
+                                                      Health&) {
+            collider.broadphaseHandle = broadphase.add(boxBounds(position, collider), BODY_BRICK, BODY_BALL,
+                                                       static_cast<int>(entity.index));
+        });
+        paddleBody = broadphase.add(Rectangle{}, BODY_PADDLE, BODY_BALL, 0);
+        ballBody = broadphase.add(Rectangle{}, BODY_BALL, BODY_BRICK | BODY_PADDLE, 0);
+        serve();
+    }
+
+    bool isOver() const { return lives <= 0 || world.archetype<BrickArchetype>().size() == 0; }
+    uint32_t getFrame() const { return frame; }
+    int getScore() const { return score; }
+    int getLives() const { return lives; }
+    float getBallX() const { return world.get<Position>(ball).x; }
+    Vector2 getBallPosition() const {
+        const Position& position = world.get<Position>(ball);
+        return Vector2{position.x, position.y};
+    }
+    float getPaddleX() const { return world.get<Position>(paddle).x; }
+    float getPaddleCentre() const {
+        return world.get<Position>(paddle).x + world.get<Collider>(paddle).width / 2;
+    }
+
+    bool step(float axis) {
+        frame++;
+        paddleInputSystem(world, PaddleInput{axis, 0.0f});
+        movementSystem(world, STEP, playfield);
+        containmentSystem(world, playfield);
+
+        Position& position = world.get<Position>(ball);
+        Velocity& velocity = world.get<Velocity>(ball);
+        const Collider& collider = world.get<Collider>(ball);
+        speedTimer += STEP;
+        if (speedTimer >= Config::SPEED_INCREASE_INTERVAL) {
+            increaseSpeed(velocity, Config::BALL_SPEED_INCREMENT, Config::MAX_BALL_SPEED);
+            speedTimer = 0.0f;
+        }
+
+        const Rectangle paddleRect = boxBounds(world.get<Position>(paddle), world.get<Collider>(paddle));
+        broadphase.update(ballBody, circleBounds(position, collider));
+        broadphase.update(paddleBody, paddleRect);
+        bool paddleCandidate = false;
+        candidates.clear();
+        for (const SweepAndPrune::Pair& pair : broadphase.findPairs()) {
+            if (pair.a != ballBody && pair.b != ballBody) {
+                continue;
+            }
+            const int other = pair.a == ballBody ? pair.b : pair.a;
+            if (other == paddleBody) {
+                paddleCandidate = true;
+            } else {
+                candidates.push_back(world.entityAt(static_cast<uint32_t>(broadphase.getUserData(other))));
+            }
+        }
+
+        float hitOffset = 0.0f;
+        const bool paddleHit = paddleCandidate &&
+                               resolveBallPaddle(position, velocity, collider, paddleRect, axis, hitOffset);
+
+        std::sort(candidates.begin(), candidates.end(), [this](Entity a, Entity b) {
+            return world.get<GridCell>(a).index < world.get<GridCell>(b).index;
+        });
+        for (Entity brick : candidates) {
+            const Rectangle brickRect = boxBounds(world.get<Position>(brick), world.get<Collider>(brick));
+            if (!resolveBallBrick(position, velocity, collider, brickRect, nextRandom())) {
+                continue;
+            }
+            Health& health = world.get<Health>(brick);
+            if (--health.hitPoints <= 0) {
+                score += health.scoreValue;
+                broadphase.remove(world.get<Collider>(brick).broadphaseHandle);
+                world.destroy(brick);
+            }
+            break;
+        }
+
+        if (position.y + collider.radius > playfield.height) {
+            lives--;
+            if (lives > 0) {
+                serve();
+            }
+        }
+        return paddleHit;
+    }
+
+    uint64_t stateHash() const {
+        const Position& position = world.get<Position>(ball);
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t value : { frame, static_cast<uint32_t>(score), static_cast<uint32_t>(lives),
+                                static_cast<uint32_t>(world.archetype<BrickArchetype>().size()) }) {
+            hash = (hash ^ value) * 1099511628211ull;
+        }
+        hash = (hash ^ static_cast<uint32_t>(position.x * 1000.0f)) * 1099511628211ull;
+        return (hash ^ static_cast<uint32_t>(position.y * 1000.0f)) * 1099511628211ull;
+    }
+
+private:
+    static constexpr float STEP = 1.0f / 60.0f;
+    enum BodyCategory : unsigned int { BODY_BALL = 1u << 0, BODY_PADDLE = 1u << 1, BODY_BRICK = 1u << 2 };
+
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    void serve() {
+        world.destroy(paddle);
+        world.destroy(ball);
+        paddle = spawnPaddle(world, playfield, Config::PADDLE_BASE_SPEED);
+        ball = spawnBall(world, playfield, Config::BALL_BASE_SPEED);
+        speedTimer = 0.0f;
+    }
+
+    Playfield playfield;
+    World world;
+    SweepAndPrune broadphase;
+    Entity paddle = NULL_ENTITY;
+    Entity ball = NULL_ENTITY;
+    int paddleBody = -1;
+    int ballBody = -1;
+    std::vector<Entity> candidates;
+    uint32_t rng;
+    float speedTimer;
+    uint32_t frame;
+    int score;
+    int lives;
+};
+
+#endif // SYSTEMS_STEP_H
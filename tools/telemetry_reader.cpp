@@ -0,0 +1,230 @@
+// Decodes a Breakout telemetry log (see include/telemetry.h) using only the
+// schemas embedded in the file. Every batch names the schema it was written
+// under, so logs appended to by different builds decode correctly; batches
+// whose schema is missing or unreadable are skipped and counted. Logs from
+// before the chunked format (a single "BKTL" header) are read too.
+//
+// Build natively: g++ -std=c++17 -O2 tools/telemetry_reader.cpp -o telemetry_reader
+// Usage:          telemetry_reader <telemetry.bktl> [--csv]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace {
+    struct EventSchema {
+        std::string name;
+        std::string fields[3];
+    };
+
+    struct Schema {
+        uint16_t version = 0;
+        uint16_t recordSize = 0;
+        std::map<int, EventSchema> events;
+    };
+
+    struct Record {
+        uint32_t timeMs;
+        uint8_t type;
+        uint8_t reserved;
+        uint16_t a;
+        int32_t b;
+        int32_t c;
+    };
+
+    bool readString(FILE* file, std::string& out) {
+        uint8_t length;
+        if (fread(&length, 1, 1, file) != 1) return false;
+        out.resize(length);
+        return length == 0 || fread(&out[0], 1, length, file) == length;
+    }
+
+    bool readEvents(FILE* file, Schema& schema) {
+        uint8_t typeCount = 0;
+        if (fread(&typeCount, sizeof(typeCount), 1, file) != 1) {
+            return false;
+        }
+        for (int i = 0; i < typeCount; i++) {
+            uint8_t id;
+            EventSchema entry;
+            bool ok = fread(&id, 1, 1, file) == 1 && readString(file, entry.name);
+            for (std::string& field : entry.fields) {
+                ok = ok && readString(file, field);
+            }
+            if (!ok) {
+                return false;
+            }
+            schema.events[id] = entry;
+        }
+        return true;
+    }
+
+    class Printer {
+    public:
+        explicit Printer(bool csv) : csv(csv) {
+            if (csv) {
+                printf("time_ms,event,a,b,c\n");
+            }
+        }
+
+        // Decodes count records (or until end of file when count is negative);
+        // returns false on a short read
+        bool printRecords(FILE* file, const Schema& schema, long long count) {
+            // Newer writers may grow the record; only the known prefix is decoded
+            std::string buffer(schema.recordSize, '\0');
+            for (long long i = 0; count < 0 || i < count; i++) {
+                if (fread(&buffer[0], 1, schema.recordSize, file) != schema.recordSize) {
+                    return count < 0;
+                }
+                Record record;
+                memcpy(&record, buffer.data(), sizeof(record));
+                print(schema, record);
+            }
+            return true;
+        }
+
+        void printTotals() const {
+            if (csv) {
+                return;
+            }
+            printf("# totals:");
+            for (const auto& count : counts) {
+                printf(" %s=%d", count.first.c_str(), count.second);
+            }
+            printf("\n");
+        }
+
+    private:
+        void print(const Schema& schema, const Record& record) {
+            auto it = schema.events.find(record.type);
+            std::string name = it != schema.events.end() ? it->second.name : "type_" + std::to_string(record.type);
+            counts[name]++;
+            const int32_t values[3] = { record.a, record.b, record.c };
+
+            if (csv) {
+                printf("%u,%s,%d,%d,%d\n", record.timeMs, name.c_str(), values[0], values[1], values[2]);
+                return;
+            }
+
+            printf("%10.3f  %-12s", record.timeMs / 1000.0, name.c_str());
+            for (int i = 0; i < 3; i++) {
+                if (it != schema.events.end() && !it->second.fields[i].empty()) {
+                    printf("  %s=%d", it->second.fields[i].c_str(), values[i]);
+                }
+            }
+            printf("\n");
+        }
+
+        bool csv;
+        std::map<std::string, int> counts;
+    };
+
+    int readLegacy(FILE* file, Printer& printer, bool csv) {
+        Schema schema;
+        if (fread(&schema.version, sizeof(schema.version), 1, file) != 1 ||
+            fread(&schema.recordSize, sizeof(schema.recordSize), 1, file) != 1 || !readEvents(file, schema)) {
+            fprintf(stderr, "truncated header\n");
+            return 1;
+        }
+        if (schema.recordSize < sizeof(Record)) {
+            fprintf(stderr, "unsupported record size %u\n", schema.recordSize);
+            return 1;
+        }
+        if (!csv) {
+            printf("# format v%u, %u byte records, %zu event types\n", schema.version, schema.recordSize,
+                   schema.events.size());
+        }
+        printer.printRecords(file, schema, -1);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <telemetry.bktl> [--csv]\n", argv[0]);
+        return 1;
+    }
+    bool csv = argc > 2 && strcmp(argv[2], "--csv") == 0;
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    Printer printer(csv);
+    char magic[4];
+    if (fread(magic, 1, 4, file) == 4 && memcmp(magic, "BKTL", 4) == 0) {
+        const int result = readLegacy(file, printer, csv);
+        fclose(file);
+        printer.printTotals();
+        return result;
+    }
+    fseek(file, 0, SEEK_SET);
+
+    std::map<uint32_t, Schema> schemas;
+    int batches = 0;
+    int skipped = 0;
+    bool corrupt = false;
+    while (fread(magic, 1, 4, file) == 4) {
+        uint16_t version = 0;
+        uint16_t recordSize = 0;
+        uint32_t schemaId = 0;
+        if (fread(&version, sizeof(version), 1, file) != 1 || fread(&recordSize, sizeof(recordSize), 1, file) != 1 ||
+            fread(&schemaId, sizeof(schemaId), 1, file) != 1) {
+            corrupt = true;
+            break;
+        }
+
+        if (memcmp(magic, "BKTS", 4) == 0) {
+            Schema schema;
+            schema.version = version;
+            schema.recordSize = recordSize;
+            if (!readEvents(file, schema)) {
+                corrupt = true;
+                break;
+            }
+            if (!csv && schemas.find(schemaId) == schemas.end()) {
+                printf("# schema %08x: format v%u, %u byte records, %zu event types\n", schemaId, version, recordSize,
+                       schema.events.size());
+            }
+            schemas[schemaId] = schema;
+            continue;
+        }
+
+        uint32_t recordCount = 0;
+        if (memcmp(magic, "BKTB", 4) != 0 || fread(&recordCount, sizeof(recordCount), 1, file) != 1) {
+            corrupt = true;
+            break;
+        }
+        batches++;
+        auto it = schemas.find(schemaId);
+        if (it == schemas.end() || it->second.recordSize != recordSize || recordSize < sizeof(Record)) {
+            // The record size in the batch header is enough to step over it
+            skipped++;
+            if (fseek(file, static_cast<long>(recordCount) * recordSize, SEEK_CUR) != 0) {
+                corrupt = true;
+                break;
+            }
+            continue;
+        }
+        if (!printer.printRecords(file, it->second, recordCount)) {
+            corrupt = true;
+            break;
+        }
+    }
+    const long offset = ftell(file);
+    fclose(file);
+
+    printer.printTotals();
+    if (!csv) {
+        printf("# %d batches, %d skipped for an unknown schema\n", batches, skipped);
+    }
+    if (corrupt) {
+        fprintf(stderr, "truncated or corrupt chunk near byte %ld\n", offset);
+        return 1;
+    }
+    return 0;
+}